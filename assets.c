@@ -0,0 +1,815 @@
+/**
+ * @file assets.c
+ * @brief Central image loader: converts every surface to the screen format once,
+ *        keeps alpha only where it is used and RLE-encodes colorkeyed sprites.
+ * @author MohamedNourMraad
+ * @date 2025-05-20
+ * @version 1.0
+ */
+
+#include <SDL/SDL.h>
+#include <SDL/SDL_image.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "assets.h"
+#include "pak.h"
+#include "loader.h"
+#include "log.h"
+
+#define ASSET_KEY_MAX 64  // Longest cache key (file name, or derived name for pages and mirrors)
+
+#define VARIANT_PLAIN 0   // The file as classified
+#define VARIANT_OPAQUE 1  // The file with alpha dropped (asset_load_opaque)
+#define VARIANT_MIRROR 2  // Mirror of another cached image
+
+/**
+ * @brief One cached surface, shared by every slot that loaded the same key and variant.
+ */
+typedef struct {
+    char key[ASSET_KEY_MAX];
+    int variant;
+    SDL_Surface *surface;  // NULL: free cache entry
+    int kind;              // ASSET_OPAQUE, ASSET_COLORKEY or ASSET_ALPHA
+    int converted;         // 0 if loaded before the video mode was set
+    int refs;              // Slots holding the surface
+} CacheEntry;
+
+/**
+ * @brief One tracked slot: where an owner keeps a cached surface.
+ */
+typedef struct {
+    SDL_Surface **slot;
+    int entry;             // Index in cache[]
+} SlotEntry;
+
+static CacheEntry *cache = NULL;
+static int cache_count = 0;
+static int cache_capacity = 0;
+static SlotEntry *registry = NULL;
+static int registry_count = 0;
+static int registry_capacity = 0;
+
+// Converted atlas pages of the open archive, loaded on first use and shared by the sprites
+static SDL_Surface **atlas_pages = NULL;
+static int atlas_page_count = 0;
+
+// Screen format the tracked surfaces were converted for
+static int format_known = 0;
+static Uint8 format_bpp;
+static Uint32 format_rmask, format_gmask, format_bmask;
+
+/**
+ * @brief Reads one pixel of a surface (the surface must be locked if needed).
+ * @param s The surface.
+ * @param x The x-coordinate.
+ * @param y The y-coordinate.
+ * @return The raw pixel value.
+ */
+static Uint32 get_pixel(SDL_Surface *s, int x, int y) {
+    Uint8 *p = (Uint8 *)s->pixels + y * s->pitch + x * s->format->BytesPerPixel;
+    switch (s->format->BytesPerPixel) {
+        case 1: return *p;
+        case 2: return *(Uint16 *)p;
+        case 3:
+            if (SDL_BYTEORDER == SDL_BIG_ENDIAN) {
+                return p[0] << 16 | p[1] << 8 | p[2];
+            }
+            return p[0] | p[1] << 8 | p[2] << 16;
+        case 4: return *(Uint32 *)p;
+        default: return 0;
+    }
+}
+
+/**
+ * @brief Decides how a freshly loaded image should be converted.
+ * @param src The loaded image.
+ * @return ASSET_OPAQUE, ASSET_COLORKEY or ASSET_ALPHA.
+ */
+static int classify_surface(SDL_Surface *src) {
+    if (src->flags & SDL_SRCCOLORKEY) {
+        return ASSET_COLORKEY; // Paletted image with a transparent index
+    }
+    if (src->format->Amask == 0) {
+        return ASSET_OPAQUE;
+    }
+    if (src->format->BytesPerPixel != 4) {
+        return ASSET_ALPHA;
+    }
+
+    int has_transparent = 0;
+    int kind = ASSET_OPAQUE;
+    if (SDL_MUSTLOCK(src)) SDL_LockSurface(src);
+    for (int y = 0; y < src->h && kind != ASSET_ALPHA; y++) {
+        Uint32 *row = (Uint32 *)((Uint8 *)src->pixels + y * src->pitch);
+        for (int x = 0; x < src->w; x++) {
+            Uint32 a = (row[x] & src->format->Amask) >> src->format->Ashift;
+            if (a == 0) {
+                has_transparent = 1;
+            } else if (a != 255) {
+                kind = ASSET_ALPHA; // Soft edges or translucency: keep per-pixel alpha
+                break;
+            }
+        }
+    }
+    if (SDL_MUSTLOCK(src)) SDL_UnlockSurface(src);
+
+    if (kind == ASSET_OPAQUE && has_transparent) {
+        kind = ASSET_COLORKEY;
+    }
+    return kind;
+}
+
+/**
+ * @brief Finds a colorkey that no opaque pixel maps to in the screen format,
+ *        then paints every transparent pixel with it.
+ * @param src A 32-bit image whose alpha is only 0 or 255.
+ * @param key_r Receives the red component of the key.
+ * @param key_g Receives the green component of the key.
+ * @param key_b Receives the blue component of the key.
+ * @return 0 on success, -1 if every candidate key is used by the image.
+ */
+static int prepare_colorkey(SDL_Surface *src, Uint8 *key_r, Uint8 *key_g, Uint8 *key_b) {
+    static const Uint8 candidates[][3] = {
+        {255, 0, 255}, {0, 255, 255}, {255, 255, 0}, {1, 254, 1}, {254, 1, 253}
+    };
+    SDL_PixelFormat *screen_format = SDL_GetVideoSurface()->format;
+    int found = -1;
+
+    if (SDL_MUSTLOCK(src)) SDL_LockSurface(src);
+    for (int c = 0; c < (int)(sizeof(candidates) / sizeof(candidates[0])) && found < 0; c++) {
+        Uint32 key = SDL_MapRGB(screen_format, candidates[c][0], candidates[c][1], candidates[c][2]);
+        int clash = 0;
+        for (int y = 0; y < src->h && !clash; y++) {
+            for (int x = 0; x < src->w; x++) {
+                Uint8 r, g, b, a;
+                SDL_GetRGBA(get_pixel(src, x, y), src->format, &r, &g, &b, &a);
+                if (a != 0 && SDL_MapRGB(screen_format, r, g, b) == key) {
+                    clash = 1;
+                    break;
+                }
+            }
+        }
+        if (!clash) found = c;
+    }
+
+    if (found >= 0) {
+        Uint32 key = SDL_MapRGBA(src->format, candidates[found][0], candidates[found][1], candidates[found][2], 0);
+        for (int y = 0; y < src->h; y++) {
+            Uint32 *row = (Uint32 *)((Uint8 *)src->pixels + y * src->pitch);
+            for (int x = 0; x < src->w; x++) {
+                if ((row[x] & src->format->Amask) == 0) {
+                    row[x] = key;
+                }
+            }
+        }
+    }
+    if (SDL_MUSTLOCK(src)) SDL_UnlockSurface(src);
+
+    if (found < 0) {
+        return -1;
+    }
+    *key_r = candidates[found][0];
+    *key_g = candidates[found][1];
+    *key_b = candidates[found][2];
+    return 0;
+}
+
+/**
+ * @brief Composites a 32-bit image over black so it can be stored without alpha.
+ * @param src The loaded image (modified in place).
+ * @return Nothing.
+ */
+static void flatten_alpha(SDL_Surface *src) {
+    if (src->format->Amask == 0 || src->format->BytesPerPixel != 4) {
+        return;
+    }
+    if (SDL_MUSTLOCK(src)) SDL_LockSurface(src);
+    for (int y = 0; y < src->h; y++) {
+        Uint32 *row = (Uint32 *)((Uint8 *)src->pixels + y * src->pitch);
+        for (int x = 0; x < src->w; x++) {
+            Uint8 r, g, b, a;
+            SDL_GetRGBA(row[x], src->format, &r, &g, &b, &a);
+            if (a != SDL_ALPHA_OPAQUE) {
+                row[x] = SDL_MapRGBA(src->format, r * a / 255, g * a / 255, b * a / 255, SDL_ALPHA_OPAQUE);
+            }
+        }
+    }
+    if (SDL_MUSTLOCK(src)) SDL_UnlockSurface(src);
+}
+
+/**
+ * @brief Converts a freshly loaded image to the screen format.
+ * @param src The loaded image (may be modified).
+ * @param kind In: the classification. Out: the conversion actually used.
+ * @return The converted surface, or NULL on failure.
+ */
+static SDL_Surface *convert_loaded(SDL_Surface *src, int *kind) {
+    SDL_Surface *conv;
+
+    if (*kind == ASSET_COLORKEY && (src->flags & SDL_SRCCOLORKEY)) {
+        conv = SDL_DisplayFormat(src); // The key travels with the conversion
+        if (conv) {
+            SDL_SetColorKey(conv, SDL_SRCCOLORKEY | SDL_RLEACCEL, conv->format->colorkey);
+        }
+        return conv;
+    }
+
+    if (*kind == ASSET_COLORKEY) {
+        Uint8 r, g, b;
+        if (prepare_colorkey(src, &r, &g, &b) == 0) {
+            SDL_SetAlpha(src, 0, SDL_ALPHA_OPAQUE); // Copy RGB as-is, key included
+            conv = SDL_DisplayFormat(src);
+            if (conv) {
+                SDL_SetColorKey(conv, SDL_SRCCOLORKEY | SDL_RLEACCEL, SDL_MapRGB(conv->format, r, g, b));
+            }
+            return conv;
+        }
+        *kind = ASSET_ALPHA; // No free key color, keep real alpha
+    }
+
+    if (*kind == ASSET_ALPHA) {
+        return SDL_DisplayFormatAlpha(src);
+    }
+    flatten_alpha(src); // No-op unless the caller forced an image with alpha to be opaque
+    SDL_SetAlpha(src, 0, SDL_ALPHA_OPAQUE); // Otherwise SDL_SRCALPHA is copied to the result and every blit blends
+    return SDL_DisplayFormat(src);
+}
+
+/**
+ * @brief Converts an already converted surface to the new screen format.
+ * @param old The surface in the previous screen format.
+ * @param kind How it was converted the first time.
+ * @return The converted surface, or NULL on failure.
+ */
+static SDL_Surface *reconvert(SDL_Surface *old, int kind) {
+    SDL_Surface *conv;
+
+    switch (kind) {
+        case ASSET_COLORKEY:
+            conv = SDL_DisplayFormat(old);
+            if (conv) {
+                SDL_SetColorKey(conv, SDL_SRCCOLORKEY | SDL_RLEACCEL, conv->format->colorkey);
+            }
+            return conv;
+        case ASSET_ALPHA:
+            return SDL_DisplayFormatAlpha(old);
+        default:
+            SDL_SetAlpha(old, 0, SDL_ALPHA_OPAQUE); // Same as convert_loaded: plain copies, no blending
+            return SDL_DisplayFormat(old);
+    }
+}
+
+/**
+ * @brief Remembers the current screen format as the one assets are converted for.
+ * @param screen The screen surface.
+ * @return Nothing.
+ */
+static void remember_format(SDL_Surface *screen) {
+    format_known = 1;
+    format_bpp = screen->format->BitsPerPixel;
+    format_rmask = screen->format->Rmask;
+    format_gmask = screen->format->Gmask;
+    format_bmask = screen->format->Bmask;
+}
+
+/**
+ * @brief Reads an image from the archive, or from its file when it is not packed.
+ * @param path The image file.
+ * @param kind Receives the packer's classification, or -1 if the pixels still need one.
+ * @return The surface (not converted), or NULL on failure.
+ */
+static SDL_Surface *read_image(const char *path, int *kind) {
+    const PakEntry *entry = pak_find(path);
+    if (entry && entry->type == PAK_IMAGE) {
+        *kind = pak_page(entry->page)->kind;
+        return pak_load_image(path);
+    }
+    SDL_Surface *src = loader_take(path, kind); // Decoded and classified in the background
+    if (src) {
+        return src;
+    }
+    *kind = -1;
+    return IMG_Load(path);
+}
+
+/**
+ * @brief Converts a surface just read to the screen format, if the video mode is set.
+ * @param src The surface (freed when converted).
+ * @param name What to call it in error messages.
+ * @param kind In: the classification. Out: the conversion actually used.
+ * @param converted Receives 1 if the surface is in the screen format.
+ * @return The surface to keep.
+ */
+static SDL_Surface *convert_read(SDL_Surface *src, const char *name, int *kind, int *converted) {
+    *converted = 0;
+    SDL_Surface *screen = SDL_GetVideoSurface();
+    if (screen == NULL) {
+        return src; // No video mode yet: converted later by asset_reconvert_all
+    }
+    if (!format_known) {
+        remember_format(screen);
+    }
+
+    SDL_Surface *conv = convert_loaded(src, kind);
+    if (conv == NULL) {
+        LOG_ERROR("Conversion de %s impossible, format d'origine conservé : %s\n", name, SDL_GetError());
+        return src;
+    }
+    SDL_FreeSurface(src);
+    *converted = 1;
+    return conv;
+}
+
+/**
+ * @brief Loads an image and converts it, reporting the conversion used.
+ * @param path The image file to load.
+ * @param forced ASSET_OPAQUE to drop alpha unconditionally, or -1 to classify the pixels.
+ * @param kind Receives ASSET_OPAQUE, ASSET_COLORKEY or ASSET_ALPHA.
+ * @param converted Receives 1 if the surface is in the screen format.
+ * @return The surface, or NULL on failure.
+ */
+static SDL_Surface *load_and_convert(const char *path, int forced, int *kind, int *converted) {
+    SDL_Surface *src = read_image(path, kind);
+    if (src == NULL) {
+        return NULL;
+    }
+    if (forced >= 0) {
+        *kind = forced;
+    } else if (*kind < 0) {
+        *kind = classify_surface(src);
+    }
+    return convert_read(src, path, kind, converted);
+}
+
+SDL_Surface *asset_decode(const char *path, int *kind) {
+    SDL_Surface *src = IMG_Load(path);
+    if (src) {
+        *kind = classify_surface(src);
+    }
+    return src;
+}
+
+SDL_Surface *asset_load_image(const char *path) {
+    int kind, converted;
+    return load_and_convert(path, -1, &kind, &converted);
+}
+
+/**
+ * @brief Finds the registry entry of a slot.
+ * @param slot The slot address.
+ * @return The entry index, or -1 if the slot is not tracked.
+ */
+static int find_entry(SDL_Surface **slot) {
+    for (int i = 0; i < registry_count; i++) {
+        if (registry[i].slot == slot) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Removes a registry entry and drops its reference; the surface is freed
+ *        with its last reference. The slot is cleared if it still holds the surface.
+ * @param index The entry index.
+ * @return Nothing.
+ */
+static void drop_entry(int index) {
+    SlotEntry *entry = &registry[index];
+    CacheEntry *cached = &cache[entry->entry];
+    if (*entry->slot == cached->surface) {
+        *entry->slot = NULL;
+    }
+    if (--cached->refs == 0) {
+        SDL_FreeSurface(cached->surface);
+        cached->surface = NULL;
+    }
+    registry[index] = registry[--registry_count];
+}
+
+/**
+ * @brief Drops the reference a slot holds, if any, and empties the slot.
+ *        Unlike asset_free, never frees an untracked surface (the slot may be uninitialized).
+ * @param slot The slot address.
+ * @return Nothing.
+ */
+static void release_slot(SDL_Surface **slot) {
+    int index = find_entry(slot);
+    if (index >= 0) {
+        drop_entry(index);
+    }
+    *slot = NULL;
+}
+
+/**
+ * @brief Looks a surface up in the cache.
+ * @param key The file name or derived name.
+ * @param variant VARIANT_PLAIN, VARIANT_OPAQUE or VARIANT_MIRROR.
+ * @return The cache index, or -1 if it is not loaded.
+ */
+static int find_cached(const char *key, int variant) {
+    for (int i = 0; i < cache_count; i++) {
+        if (cache[i].surface && cache[i].variant == variant && strcmp(cache[i].key, key) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Stores a new surface in the cache (with no reference yet).
+ * @param key The file name or derived name.
+ * @param variant VARIANT_PLAIN, VARIANT_OPAQUE or VARIANT_MIRROR.
+ * @param surface The surface, owned by the cache from now on.
+ * @param kind How the surface was converted (or is to be).
+ * @param converted 1 if the surface is in the screen format.
+ * @return The cache index, or -1 if out of memory (the surface is freed).
+ */
+static int add_cached(const char *key, int variant, SDL_Surface *surface, int kind, int converted) {
+    int index = -1;
+    for (int i = 0; i < cache_count && index < 0; i++) {
+        if (cache[i].surface == NULL) index = i; // Reuse a freed entry, indices stay stable
+    }
+    if (index < 0) {
+        if (cache_count == cache_capacity) {
+            int capacity = cache_capacity ? cache_capacity * 2 : 128;
+            CacheEntry *grown = realloc(cache, capacity * sizeof(CacheEntry));
+            if (grown == NULL) {
+                LOG_ERROR("Cache d'images plein, %s abandonné\n", key);
+                SDL_FreeSurface(surface);
+                return -1;
+            }
+            cache = grown;
+            cache_capacity = capacity;
+        }
+        index = cache_count++;
+    }
+    CacheEntry *cached = &cache[index];
+    snprintf(cached->key, sizeof(cached->key), "%s", key);
+    cached->variant = variant;
+    cached->surface = surface;
+    cached->kind = kind;
+    cached->converted = converted;
+    cached->refs = 0;
+    return index;
+}
+
+/**
+ * @brief Points a slot at a cached surface and takes a reference. Whatever the slot
+ *        was tracking before is released afterwards, so reloading the same file reuses it.
+ * @param slot Address of the surface pointer to fill.
+ * @param index The cache index.
+ * @return The surface, or NULL if the registry is out of memory.
+ */
+static SDL_Surface *hold(SDL_Surface **slot, int index) {
+    int old = find_entry(slot);
+    if (old < 0 && registry_count == registry_capacity) {
+        int capacity = registry_capacity ? registry_capacity * 2 : 128;
+        SlotEntry *grown = realloc(registry, capacity * sizeof(SlotEntry));
+        if (grown == NULL) {
+            LOG_ERROR("Registre d'assets plein, %s non chargé\n", cache[index].key);
+            if (cache[index].refs == 0) {
+                SDL_FreeSurface(cache[index].surface);
+                cache[index].surface = NULL;
+            }
+            *slot = NULL;
+            return NULL;
+        }
+        registry = grown;
+        registry_capacity = capacity;
+    }
+
+    cache[index].refs++;
+    if (old >= 0) {
+        int previous = registry[old].entry;
+        registry[old].entry = index;
+        if (--cache[previous].refs == 0) {
+            SDL_FreeSurface(cache[previous].surface);
+            cache[previous].surface = NULL;
+        }
+    } else {
+        registry[registry_count].slot = slot;
+        registry[registry_count].entry = index;
+        registry_count++;
+    }
+    *slot = cache[index].surface;
+    return *slot;
+}
+
+/**
+ * @brief Loads an image into a tracked slot, sharing it if another slot already loaded it.
+ * @param slot Address of the surface pointer to fill.
+ * @param path The image file to load.
+ * @param forced ASSET_OPAQUE to drop alpha unconditionally, or -1 to classify the pixels.
+ * @return The converted surface, or NULL on failure.
+ */
+static SDL_Surface *load_tracked(SDL_Surface **slot, const char *path, int forced) {
+    int variant = (forced == ASSET_OPAQUE) ? VARIANT_OPAQUE : VARIANT_PLAIN;
+    int index = find_cached(path, variant);
+    if (index < 0) {
+        int kind, converted;
+        SDL_Surface *surface = load_and_convert(path, forced, &kind, &converted);
+        if (surface == NULL) {
+            release_slot(slot); // A failed reload empties the slot
+            return NULL;
+        }
+        index = add_cached(path, variant, surface, kind, converted);
+        if (index < 0) {
+            release_slot(slot);
+            return NULL;
+        }
+    }
+    return hold(slot, index);
+}
+
+SDL_Surface *asset_load(SDL_Surface **slot, const char *path) {
+    return load_tracked(slot, path, -1);
+}
+
+SDL_Surface *asset_load_opaque(SDL_Surface **slot, const char *path) {
+    return load_tracked(slot, path, ASSET_OPAQUE);
+}
+
+void asset_free(SDL_Surface **slot) {
+    int index = find_entry(slot);
+    if (index >= 0) {
+        drop_entry(index);
+    }
+    if (*slot) {
+        SDL_FreeSurface(*slot);
+        *slot = NULL;
+    }
+}
+
+int asset_open_archive(const char *path) {
+    asset_close_archive();
+    if (pak_open(path) < 0) {
+        LOG_INFO("Pas d'archive %s, chargement depuis les fichiers\n", path);
+        return -1;
+    }
+    atlas_page_count = pak_page_count();
+    atlas_pages = calloc(atlas_page_count ? atlas_page_count : 1, sizeof(SDL_Surface *));
+    if (atlas_pages == NULL) {
+        pak_close();
+        atlas_page_count = 0;
+        return -1;
+    }
+    return 0;
+}
+
+void asset_close_archive(void) {
+    for (int i = 0; i < atlas_page_count; i++) {
+        asset_free(&atlas_pages[i]);
+    }
+    free(atlas_pages);
+    atlas_pages = NULL;
+    atlas_page_count = 0;
+    pak_close();
+}
+
+SDL_RWops *asset_open_rw(const char *path) {
+    SDL_RWops *rw = pak_open_rw(path);
+    return rw ? rw : SDL_RWFromFile(path, "rb");
+}
+
+SDL_Surface *asset_load_raw(const char *path) {
+    SDL_Surface *src = pak_load_image(path);
+    if (src == NULL) {
+        int kind;
+        src = loader_take(path, &kind);
+    }
+    return src ? src : IMG_Load(path);
+}
+
+/**
+ * @brief Converts an atlas page the first time one of its sprites is loaded.
+ * @param page The page index.
+ * @return The page in the screen format (tracked, owned by the archive), or NULL on failure.
+ */
+static SDL_Surface *load_page(Uint32 page) {
+    if (atlas_pages[page] == NULL) {
+        SDL_Surface *src = pak_load_page(page);
+        if (src == NULL) {
+            return NULL;
+        }
+        char key[ASSET_KEY_MAX];
+        snprintf(key, sizeof(key), "#page%u", page); // File names never start with '#'
+        int kind = pak_page(page)->kind, converted;
+        SDL_Surface *surface = convert_read(src, key, &kind, &converted);
+        int index = add_cached(key, VARIANT_PLAIN, surface, kind, converted);
+        if (index < 0) {
+            return NULL;
+        }
+        hold(&atlas_pages[page], index);
+    }
+    return atlas_pages[page];
+}
+
+SDL_Surface *asset_load_sprite(AssetSprite *sprite, const char *path) {
+    const PakEntry *entry = pak_find(path);
+    if (entry && entry->type == PAK_IMAGE && load_page(entry->page) != NULL) {
+        release_slot(&sprite->own); // Reloading a sprite that had its own surface
+        sprite->source = &atlas_pages[entry->page];
+        sprite->rect.x = entry->x;
+        sprite->rect.y = entry->y;
+        sprite->rect.w = entry->w;
+        sprite->rect.h = entry->h;
+        return *sprite->source;
+    }
+
+    sprite->source = NULL;
+    if (asset_load(&sprite->own, path) == NULL) {
+        return NULL;
+    }
+    sprite->source = &sprite->own;
+    sprite->rect.x = 0;
+    sprite->rect.y = 0;
+    sprite->rect.w = sprite->own->w;
+    sprite->rect.h = sprite->own->h;
+    return sprite->own;
+}
+
+/**
+ * @brief Copies a rect of a surface into a new surface of the same format, mirrored horizontally.
+ *        Each row is read forwards and written backwards, which compilers vectorize.
+ * @param src The surface, already locked by the caller (see lock_source).
+ * @param rect The part to copy.
+ * @return The mirrored copy with the same colorkey, or NULL on failure.
+ */
+static SDL_Surface *mirror_copy(SDL_Surface *src, const SDL_Rect *rect) {
+    SDL_PixelFormat *f = src->format;
+    SDL_Surface *dst = SDL_CreateRGBSurface(SDL_SWSURFACE, rect->w, rect->h, f->BitsPerPixel,
+                                            f->Rmask, f->Gmask, f->Bmask, f->Amask);
+    if (dst == NULL) {
+        return NULL;
+    }
+    if (f->palette) {
+        SDL_SetColors(dst, f->palette->colors, 0, f->palette->ncolors);
+    }
+
+    int bpp = f->BytesPerPixel;
+    int w = rect->w;
+    for (int y = 0; y < rect->h; y++) {
+        const Uint8 *in = (const Uint8 *)src->pixels + (rect->y + y) * src->pitch + rect->x * bpp;
+        Uint8 *out = (Uint8 *)dst->pixels + y * dst->pitch;
+        if (bpp == 4) {
+            const Uint32 *in32 = (const Uint32 *)in;
+            Uint32 *out32 = (Uint32 *)out;
+            for (int x = 0; x < w; x++) {
+                out32[x] = in32[w - 1 - x];
+            }
+        } else {
+            for (int x = 0; x < w; x++) {
+                memcpy(out + x * bpp, in + (w - 1 - x) * bpp, bpp);
+            }
+        }
+    }
+
+    if (src->flags & SDL_SRCCOLORKEY) {
+        SDL_SetColorKey(dst, SDL_SRCCOLORKEY | SDL_RLEACCEL, f->colorkey);
+    }
+    return dst;
+}
+
+/**
+ * @brief Keeps one source surface locked across a batch of mirrors. Locking an RLE
+ *        surface decodes it and unlocking encodes it again, which for an atlas page
+ *        costs far more than the copy itself.
+ * @param locked The surface locked so far (NULL if none), updated.
+ * @param surface The surface to lock, or NULL to only unlock.
+ * @return Nothing.
+ */
+static void lock_source(SDL_Surface **locked, SDL_Surface *surface) {
+    if (*locked == surface) {
+        return;
+    }
+    if (*locked && SDL_MUSTLOCK(*locked)) {
+        SDL_UnlockSurface(*locked);
+    }
+    *locked = surface;
+    if (surface && SDL_MUSTLOCK(surface)) {
+        SDL_LockSurface(surface);
+    }
+}
+
+/**
+ * @brief Mirrors one sprite, reusing the cached mirror of the same rect if there is one.
+ * @param mirror The sprite to fill.
+ * @param sprite The loaded sprite to mirror.
+ * @param locked Source surface locked by the batch, updated (see lock_source).
+ * @return The surface to blit mirror->rect from, or NULL on failure.
+ */
+static SDL_Surface *mirror_sprite(AssetSprite *mirror, const AssetSprite *sprite, SDL_Surface **locked) {
+    int origin = sprite->source ? find_entry(sprite->source) : -1;
+    if (origin < 0) {
+        LOG_ERROR("Impossible de retourner une image qui n'a pas été chargée\n");
+        release_slot(&mirror->own);
+        mirror->source = NULL;
+        return NULL;
+    }
+
+    // Keyed by the original and the rect, so every player mirroring the same frame shares it
+    const CacheEntry *original = &cache[registry[origin].entry];
+    char key[ASSET_KEY_MAX];
+    snprintf(key, sizeof(key), "%s@%d,%d", original->key, sprite->rect.x, sprite->rect.y);
+    int index = find_cached(key, VARIANT_MIRROR);
+    if (index < 0) {
+        lock_source(locked, original->surface);
+        SDL_Surface *surface = mirror_copy(original->surface, &sprite->rect);
+        if (surface == NULL) {
+            LOG_ERROR("Impossible de retourner %s : %s\n", original->key, SDL_GetError());
+            release_slot(&mirror->own);
+            mirror->source = NULL;
+            return NULL;
+        }
+        // Same pixel format as the original, so it follows video mode changes the same way
+        index = add_cached(key, VARIANT_MIRROR, surface, original->kind, original->converted);
+        if (index < 0) {
+            release_slot(&mirror->own);
+            mirror->source = NULL;
+            return NULL;
+        }
+    }
+    if (hold(&mirror->own, index) == NULL) {
+        mirror->source = NULL;
+        return NULL;
+    }
+    mirror->source = &mirror->own;
+    mirror->rect.x = 0;
+    mirror->rect.y = 0;
+    mirror->rect.w = mirror->own->w;
+    mirror->rect.h = mirror->own->h;
+    return mirror->own;
+}
+
+SDL_Surface *asset_mirror_sprite(AssetSprite *mirror, const AssetSprite *sprite) {
+    SDL_Surface *locked = NULL;
+    SDL_Surface *surface = mirror_sprite(mirror, sprite, &locked);
+    lock_source(&locked, NULL);
+    return surface;
+}
+
+int asset_mirror_sprites(AssetSprite *const *mirrors, const AssetSprite *const *sprites, int count) {
+    SDL_Surface *locked = NULL;
+    int built = 0;
+    for (int i = 0; i < count; i++) {
+        if (mirror_sprite(mirrors[i], sprites[i], &locked) != NULL) {
+            built++;
+        }
+    }
+    lock_source(&locked, NULL);
+    return built;
+}
+
+void asset_free_sprite(AssetSprite *sprite) {
+    asset_free(&sprite->own);
+    sprite->source = NULL; // Atlas pages stay until asset_close_archive
+}
+
+void asset_reconvert_all(void) {
+    SDL_Surface *screen = SDL_GetVideoSurface();
+    if (screen == NULL) {
+        return;
+    }
+    remember_format(screen);
+
+    for (int i = 0; i < cache_count; i++) {
+        CacheEntry *cached = &cache[i];
+        if (cached->surface == NULL) {
+            continue;
+        }
+        SDL_Surface *conv = cached->converted ? reconvert(cached->surface, cached->kind)
+                                              : convert_loaded(cached->surface, &cached->kind);
+        if (conv == NULL) {
+            LOG_ERROR("Reconversion de %s impossible : %s\n", cached->key, SDL_GetError());
+            continue;
+        }
+        for (int j = 0; j < registry_count; j++) {
+            // Slots whose owner replaced the surface behind our back are left alone
+            if (registry[j].entry == i && *registry[j].slot == cached->surface) {
+                *registry[j].slot = conv;
+            }
+        }
+        SDL_FreeSurface(cached->surface);
+        cached->surface = conv;
+        cached->converted = 1;
+    }
+}
+
+SDL_Surface *asset_set_video_mode(int width, int height, int bpp, Uint32 flags) {
+    SDL_Surface *screen = SDL_SetVideoMode(width, height, bpp, flags);
+    if (screen == NULL) {
+        return NULL;
+    }
+
+    // Video memory does not survive a mode switch; otherwise only a new pixel format matters
+    if (!format_known || (screen->flags & SDL_HWSURFACE) ||
+        screen->format->BitsPerPixel != format_bpp ||
+        screen->format->Rmask != format_rmask ||
+        screen->format->Gmask != format_gmask ||
+        screen->format->Bmask != format_bmask) {
+        asset_reconvert_all();
+    }
+    return screen;
+}
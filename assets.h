@@ -0,0 +1,158 @@
+/**
+ * @file assets.h
+ * @brief Central image loader that converts surfaces to the screen format.
+ * @author MohamedNourMraad
+ * @date 2025-05-20
+ * @version 1.0
+ */
+
+#ifndef ASSETS_H
+#define ASSETS_H
+
+#include <SDL/SDL.h>
+#include <SDL/SDL_image.h>
+
+#define ASSET_OPAQUE 0    // No transparency: plain SDL_DisplayFormat
+#define ASSET_COLORKEY 1  // Alpha is only 0 or 255: colorkey + RLE
+#define ASSET_ALPHA 2     // Real translucency: SDL_DisplayFormatAlpha
+
+/**
+ * @brief An image that may live in a shared atlas page: blit rect out of *source.
+ *        A zeroed sprite is empty; it must stay at the same address until asset_free_sprite.
+ */
+typedef struct {
+    SDL_Surface **source;  // Atlas page slot, or &own; follows video mode changes
+    SDL_Surface *own;      // The image itself when it is not in the archive
+    SDL_Rect rect;         // Part of *source holding the image
+} AssetSprite;
+
+/**
+ * @brief Loads an image and converts it to the current screen format.
+ *        The surface is not tracked: the caller frees it with SDL_FreeSurface.
+ * @param path The image file to load.
+ * @return The converted surface, or NULL on failure (see IMG_GetError).
+ */
+SDL_Surface *asset_load_image(const char *path);
+
+/**
+ * @brief Decodes and classifies an image file without converting it. Touches no shared
+ *        state, so the background loader calls it from its worker threads.
+ * @param path The image file.
+ * @param kind Receives ASSET_OPAQUE, ASSET_COLORKEY or ASSET_ALPHA.
+ * @return The decoded surface (owned by the caller), or NULL on failure.
+ */
+SDL_Surface *asset_decode(const char *path, int *kind);
+
+/**
+ * @brief Loads an image into *slot, converts it to the screen format and remembers
+ *        the slot so the surface can be re-converted after a video mode change.
+ *        Slots loading the same file share one reference-counted surface, decoded once:
+ *        it must never be modified. A surface previously loaded into the same slot is released.
+ * @param slot Address of the surface pointer to fill (must stay valid until asset_free).
+ * @param path The image file to load.
+ * @return The converted surface (also stored in *slot), or NULL on failure.
+ */
+SDL_Surface *asset_load(SDL_Surface **slot, const char *path);
+
+/**
+ * @brief Like asset_load, but always stores the image without alpha
+ *        (translucent pixels are composited over black). Meant for full-screen backgrounds.
+ * @param slot Address of the surface pointer to fill (must stay valid until asset_free).
+ * @param path The image file to load.
+ * @return The converted surface (also stored in *slot), or NULL on failure.
+ */
+SDL_Surface *asset_load_opaque(SDL_Surface **slot, const char *path);
+
+/**
+ * @brief Releases the surface in *slot (freed with its last slot), forgets the slot
+ *        and sets it to NULL. An untracked surface in *slot is freed.
+ * @param slot Address of the surface pointer (may point to NULL).
+ * @return Nothing.
+ */
+void asset_free(SDL_Surface **slot);
+
+/**
+ * @brief Maps the asset archive. Images, sounds and fonts found in it are read from
+ *        the mapping instead of their files; everything else still loads from disk.
+ * @param path The archive file (PAK_FILE).
+ * @return 0 on success, -1 if there is no usable archive (loose files are used).
+ */
+int asset_open_archive(const char *path);
+
+/**
+ * @brief Frees the atlas pages and unmaps the archive. Call it after every
+ *        sprite, font and sound loaded from the archive has been released.
+ * @return Nothing.
+ */
+void asset_close_archive(void);
+
+/**
+ * @brief Opens a sound, font or other raw file, from the archive if it holds it.
+ * @param path The file name.
+ * @return A stream for the *_RW loaders, or NULL if the file cannot be opened.
+ */
+SDL_RWops *asset_open_rw(const char *path);
+
+/**
+ * @brief Reads an image without converting it (collision maps read pixel by pixel).
+ *        The caller frees it with SDL_FreeSurface.
+ * @param path The image file.
+ * @return The surface, or NULL on failure (see IMG_GetError).
+ */
+SDL_Surface *asset_load_raw(const char *path);
+
+/**
+ * @brief Loads an image as a sprite: a rect of its converted atlas page when the archive
+ *        holds it (one surface for all the frames of a page), its own surface otherwise.
+ * @param sprite The sprite to fill.
+ * @param path The image file.
+ * @return The surface to blit sprite->rect from, or NULL on failure.
+ */
+SDL_Surface *asset_load_sprite(AssetSprite *sprite, const char *path);
+
+/**
+ * @brief Builds the horizontal mirror of a loaded sprite (left-facing frames from the
+ *        right-facing ones) without decoding anything. The mirror gets its own surface.
+ *        To mirror several frames of one atlas page, use asset_mirror_sprites.
+ * @param mirror The sprite to fill (must stay at the same address until asset_free_sprite).
+ * @param sprite The loaded sprite to mirror.
+ * @return The surface to blit mirror->rect from, or NULL on failure.
+ */
+SDL_Surface *asset_mirror_sprite(AssetSprite *mirror, const AssetSprite *sprite);
+
+/**
+ * @brief Mirrors several sprites like asset_mirror_sprite, locking each source surface
+ *        once for the whole batch: an RLE atlas page is unpacked and packed again once,
+ *        not once per frame.
+ * @param mirrors The sprites to fill.
+ * @param sprites The loaded sprites to mirror (sprites[i] into mirrors[i]).
+ * @param count Number of sprites.
+ * @return The number of mirrors built (failed ones have a NULL source).
+ */
+int asset_mirror_sprites(AssetSprite *const *mirrors, const AssetSprite *const *sprites, int count);
+
+/**
+ * @brief Releases a sprite (atlas pages are kept for the other sprites) and empties it.
+ * @param sprite The sprite.
+ * @return Nothing.
+ */
+void asset_free_sprite(AssetSprite *sprite);
+
+/**
+ * @brief Sets the video mode and re-converts every tracked surface if the
+ *        screen format changed (or the screen lives in video memory).
+ * @param width Screen width.
+ * @param height Screen height.
+ * @param bpp Bits per pixel.
+ * @param flags SDL video flags.
+ * @return The new screen surface, or NULL on failure.
+ */
+SDL_Surface *asset_set_video_mode(int width, int height, int bpp, Uint32 flags);
+
+/**
+ * @brief Re-converts every tracked surface to the current screen format.
+ * @return Nothing.
+ */
+void asset_reconvert_all(void);
+
+#endif // ASSETS_H
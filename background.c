@@ -9,84 +9,110 @@
 #include <SDL/SDL.h>
 #include <SDL/SDL_image.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include "background.h"
+#include "assets.h"
+#include "dirty.h"
 #include "personne.h"
+#include "log.h"
+#include "input.h"
 
 #define SCREEN_WIDTH 1280  // New screen width
 
+// Files of each level: visual background, collision map and door sprite sheet
+static const char *const level_images[2] = {"background1.png", "background2.png"};
+static const char *const level_maps[2] = {"backgroundpinkgreen1.png", "backgroundpinkgreen2.png"};
+static const char *const level_doors[2][6] = {
+    {"porte1.png", "porte2.png", "porte3.png", "porte4.png", "porte5.png", "porte6.png"},
+    {"prt1.png", "prt2.png", "prt3.png", "prt4.png", "prt5.png", "prt6.png"}
+};
+
 /**
- * @brief Initializes the background with image, collision map, and door sprites.
+ * @brief Points at the fields that hold the assets of one level.
  * @param bg Pointer to the background structure.
- * @return 0 on success, -1 on failure.
+ * @param level The level (1 or 2).
+ * @param image Receives the address of the visual background slot.
+ * @param mask Receives the address of the collision mask.
+ * @param doors Receives the door sprite slots.
+ * @return Nothing.
  */
-int init_background(Background *bg) {
-    // Initialize level 1 background
-    bg->image_level1 = IMG_Load("background1.png"); // Visual overlay for level 1
-    if (bg->image_level1 == NULL) {
-        fprintf(stderr, "Erreur de chargement de background1.png : %s\n", IMG_GetError());
-        return -1;
+static void level_fields(Background *bg, int level, SDL_Surface ***image, CollisionMask **mask, SDL_Surface ***doors) {
+    if (level == 1) {
+        *image = &bg->image_level1;
+        *mask = &bg->collision_level1;
+        *doors = bg->door_images;
+    } else {
+        *image = &bg->image_level2;
+        *mask = &bg->collision_level2;
+        *doors = bg->door_images_level2;
     }
+}
 
-    bg->collision_map_level1 = IMG_Load("backgroundpinkgreen1.png"); // Collision map for level 1
-    if (bg->collision_map_level1 == NULL) {
-        fprintf(stderr, "Erreur de chargement de backgroundpinkgreen1.png : %s\n", IMG_GetError());
-        SDL_FreeSurface(bg->image_level1);
-        return -1;
+int background_load_level(Background *bg, int level) {
+    SDL_Surface **image, **doors;
+    CollisionMask *mask;
+    SDL_Surface *collision_map;
+    const char *const *names = level_doors[level - 1];
+
+    level_fields(bg, level, &image, &mask, &doors);
+    if (*image != NULL) {
+        return 0; // Already resident
     }
 
-    // Initialize level 2 background
-    bg->image_level2 = IMG_Load("background2.png"); // Visual overlay for level 2
-    if (bg->image_level2 == NULL) {
-        fprintf(stderr, "Erreur de chargement de background2.png : %s\n", IMG_GetError());
-        SDL_FreeSurface(bg->image_level1);
-        SDL_FreeSurface(bg->collision_map_level1);
+    asset_load_opaque(image, level_images[level - 1]); // Visual overlay
+    if (*image == NULL) {
+        LOG_ERROR("Erreur de chargement de %s : %s\n", level_images[level - 1], IMG_GetError());
         return -1;
     }
 
-    bg->collision_map_level2 = IMG_Load("backgroundpinkgreen2.png"); // Collision map for level 2
-    if (bg->collision_map_level2 == NULL) {
-        fprintf(stderr, "Erreur de chargement de backgroundpinkgreen2.png : %s\n", IMG_GetError());
-        SDL_FreeSurface(bg->image_level1);
-        SDL_FreeSurface(bg->collision_map_level1);
-        SDL_FreeSurface(bg->image_level2);
+    collision_map = asset_load_raw(level_maps[level - 1]);
+    if (collision_map == NULL) {
+        LOG_ERROR("Erreur de chargement de %s : %s\n", level_maps[level - 1], IMG_GetError());
+        background_free_level(bg, level);
+        return -1;
+    }
+    if (build_collision_mask(collision_map, mask) < 0) {
+        LOG_ERROR("Erreur de construction du masque de collision du niveau %d\n", level);
+        SDL_FreeSurface(collision_map);
+        background_free_level(bg, level);
         return -1;
     }
+    SDL_FreeSurface(collision_map); // Only the packed mask is kept
 
-    // Load door sprite sheet images for level 1 (porte1.png to porte6.png)
-    char door_filenames_level1[6][12] = {"porte1.png", "porte2.png", "porte3.png", "porte4.png", "porte5.png", "porte6.png"};
     for (int i = 0; i < 6; i++) {
-        bg->door_images[i] = IMG_Load(door_filenames_level1[i]);
-        if (bg->door_images[i] == NULL) {
-            fprintf(stderr, "Erreur de chargement de %s : %s\n", door_filenames_level1[i], IMG_GetError());
-            for (int j = 0; j < i; j++) {
-                SDL_FreeSurface(bg->door_images[j]);
-            }
-            SDL_FreeSurface(bg->image_level1);
-            SDL_FreeSurface(bg->collision_map_level1);
-            SDL_FreeSurface(bg->image_level2);
-            SDL_FreeSurface(bg->collision_map_level2);
+        asset_load(&doors[i], names[i]);
+        if (doors[i] == NULL) {
+            LOG_ERROR("Erreur de chargement de %s : %s\n", names[i], IMG_GetError());
+            background_free_level(bg, level);
             return -1;
         }
     }
+    LOG_INFO("Niveau %d : fond, masque de collision et porte chargés\n", level);
+    return 0;
+}
 
-    // Load door sprite sheet images for level 2 (prt1.png to prt6.png)
-    char door_filenames_level2[6][12] = {"prt1.png", "prt2.png", "prt3.png", "prt4.png", "prt5.png", "prt6.png"};
+void background_free_level(Background *bg, int level) {
+    SDL_Surface **image, **doors;
+    CollisionMask *mask;
+
+    level_fields(bg, level, &image, &mask, &doors);
+    asset_free(image);
+    free_collision_mask(mask);
     for (int i = 0; i < 6; i++) {
-        bg->door_images_level2[i] = IMG_Load(door_filenames_level2[i]);
-        if (bg->door_images_level2[i] == NULL) {
-            fprintf(stderr, "Erreur de chargement de %s : %s\n", door_filenames_level2[i], IMG_GetError());
-            for (int j = 0; j < i; j++) {
-                SDL_FreeSurface(bg->door_images_level2[j]);
-            }
-            for (int j = 0; j < 6; j++) {
-                SDL_FreeSurface(bg->door_images[j]);
-            }
-            SDL_FreeSurface(bg->image_level1);
-            SDL_FreeSurface(bg->collision_map_level1);
-            SDL_FreeSurface(bg->image_level2);
-            SDL_FreeSurface(bg->collision_map_level2);
-            return -1;
-        }
+        asset_free(&doors[i]);
+    }
+}
+
+/**
+ * @brief Initializes the background with image, collision map, and door sprites.
+ * @param bg Pointer to the background structure.
+ * @return 0 on success, -1 on failure.
+ */
+int init_background(Background *bg) {
+    // Only level 1 is loaded here: later levels come with background_load_level
+    if (background_load_level(bg, 1) < 0) {
+        return -1;
     }
 
     bg->camera.x = 0;
@@ -109,7 +135,7 @@ int init_background(Background *bg) {
     bg->door_position_level2.h = 100;
 
     bg->door_frame = 0;
-    bg->door_anim_start_time = SDL_GetTicks();
+    bg->door_anim_start_time = input_ticks();
     bg->door_anim_stopped = 0; // Initialize animation stop flag
     bg->door_anim_reverse = 0;
 
@@ -117,44 +143,280 @@ int init_background(Background *bg) {
 }
 
 /**
- * @brief Displays the background on the screen with scrolling effect.
- * @param bg The background structure.
- * @param screen The SDL surface to render on.
+ * @brief Builds the per-column run table for one pixel class of a packed mask.
+ * @param mask The packed collision mask (bits already filled).
+ * @param value The pixel class to index (COLLISION_WALKABLE or COLLISION_OBSTACLE).
+ * @param index Receives w + 1 offsets into runs.
+ * @param runs Receives the runs, column by column, top to bottom.
+ * @return 0 on success, -1 on failure.
+ */
+static int build_run_table(const CollisionMask *mask, int value, int **index, SurfaceRun **runs) {
+    *index = malloc((mask->w + 1) * sizeof(int));
+    if (*index == NULL) {
+        return -1;
+    }
+
+    // First pass: count runs per column
+    int total = 0;
+    for (int x = 0; x < mask->w; x++) {
+        (*index)[x] = total;
+        int inside = 0;
+        for (int y = 0; y < mask->h; y++) {
+            int match = collision_mask_get(mask, x, y) == value;
+            if (match && !inside) total++;
+            inside = match;
+        }
+    }
+    (*index)[mask->w] = total;
+
+    *runs = malloc((total > 0 ? total : 1) * sizeof(SurfaceRun));
+    if (*runs == NULL) {
+        free(*index);
+        *index = NULL;
+        return -1;
+    }
+
+    // Second pass: record top and bottom of each run
+    int n = 0;
+    for (int x = 0; x < mask->w; x++) {
+        int inside = 0;
+        for (int y = 0; y < mask->h; y++) {
+            int match = collision_mask_get(mask, x, y) == value;
+            if (match && !inside) {
+                (*runs)[n].top = y;
+            } else if (!match && inside) {
+                (*runs)[n++].bottom = y - 1;
+            }
+            inside = match;
+        }
+        if (inside) {
+            (*runs)[n++].bottom = mask->h - 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Builds a packed collision mask from a pink/green collision map image.
+ * @param map The collision map surface (any pixel format).
+ * @param mask Pointer to the mask to fill.
+ * @return 0 on success, -1 on failure.
+ */
+int build_collision_mask(SDL_Surface *map, CollisionMask *mask) {
+    mask->w = map->w;
+    mask->h = map->h;
+    mask->pitch = (map->w + 3) / 4;
+    mask->walk_index = NULL;
+    mask->walk_runs = NULL;
+    mask->block_index = NULL;
+    mask->block_runs = NULL;
+    mask->bits = calloc(mask->h, mask->pitch);
+    if (mask->bits == NULL) {
+        LOG_ERROR("Erreur d'allocation du masque de collision (%dx%d)\n", map->w, map->h);
+        return -1;
+    }
+
+    if (SDL_MUSTLOCK(map)) {
+        SDL_LockSurface(map);
+    }
+
+    // Classify every pixel once; check_collision never touches the surface again
+    int bpp = map->format->BytesPerPixel;
+    for (int y = 0; y < map->h; y++) {
+        Uint8 *row = (Uint8 *)map->pixels + y * map->pitch;
+        Uint8 *mask_row = mask->bits + y * mask->pitch;
+        for (int x = 0; x < map->w; x++) {
+            Uint8 *p = row + x * bpp;
+            Uint32 pixel;
+            Uint8 r, g, b;
+            switch (bpp) {
+                case 1:
+                    pixel = *p;
+                    break;
+                case 2:
+                    pixel = *(Uint16 *)p;
+                    break;
+                case 3:
+                    if (SDL_BYTEORDER == SDL_BIG_ENDIAN) {
+                        pixel = p[0] << 16 | p[1] << 8 | p[2];
+                    } else {
+                        pixel = p[0] | p[1] << 8 | p[2] << 16;
+                    }
+                    break;
+                case 4:
+                    pixel = *(Uint32 *)p;
+                    break;
+                default:
+                    pixel = 0;
+            }
+            SDL_GetRGB(pixel, map->format, &r, &g, &b);
+
+            Uint8 value = COLLISION_NONE;
+            if (r == 255 && g == 0 && b == 222) {        // Pink: #ff00de
+                value = COLLISION_WALKABLE;
+            } else if (r == 0 && g == 255 && b == 12) {  // Green: #00ff0c
+                value = COLLISION_OBSTACLE;
+            }
+            mask_row[x >> 2] |= value << ((x & 3) << 1);
+        }
+    }
+
+    if (SDL_MUSTLOCK(map)) {
+        SDL_UnlockSurface(map);
+    }
+
+    if (build_run_table(mask, COLLISION_WALKABLE, &mask->walk_index, &mask->walk_runs) < 0 ||
+        build_run_table(mask, COLLISION_OBSTACLE, &mask->block_index, &mask->block_runs) < 0) {
+        LOG_ERROR("Erreur d'allocation des tables de surfaces (%dx%d)\n", map->w, map->h);
+        free_collision_mask(mask);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Returns the first y of a column's runs that lies in [y_from, y_to].
+ * @param index Per-column offsets into runs.
+ * @param runs Runs sorted by y inside each column.
+ * @param x The column.
+ * @param y_from First y to consider.
+ * @param y_to Last y to consider (inclusive).
+ * @return The smallest matching y, or -1 if there is none.
+ */
+static int first_in_runs(const int *index, const SurfaceRun *runs, int x, int y_from, int y_to) {
+    int lo = index[x];
+    int hi = index[x + 1];
+
+    // Binary search for the first run that ends at or below y_from
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (runs[mid].bottom < y_from) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo == index[x + 1] || runs[lo].top > y_to) {
+        return -1;
+    }
+    return runs[lo].top > y_from ? runs[lo].top : y_from;
+}
+
+int collision_first_walkable(const CollisionMask *mask, int x, int y_from, int y_to) {
+    return first_in_runs(mask->walk_index, mask->walk_runs, x, y_from, y_to);
+}
+
+int collision_first_obstacle(const CollisionMask *mask, int x, int y_from, int y_to) {
+    return first_in_runs(mask->block_index, mask->block_runs, x, y_from, y_to);
+}
+
+/**
+ * @brief Frees a packed collision mask.
+ * @param mask Pointer to the mask to free.
  * @return Nothing.
  */
-void display_background(Background bg, SDL_Surface *screen) {
-    SDL_Surface *current_image = (bg.level == 1) ? bg.image_level1 : bg.image_level2;
-    SDL_Rect src = {bg.camera.x, bg.camera.y, screen->w, screen->h}; // Scroll based on camera
-    SDL_Rect dst = {0, 0, screen->w, screen->h};                     // Destination on screen
-    SDL_BlitSurface(current_image, &src, screen, &dst);
-    display_door(bg, screen); // Display door animation
+void free_collision_mask(CollisionMask *mask) {
+    free(mask->bits);
+    mask->bits = NULL;
+    free(mask->walk_index);
+    mask->walk_index = NULL;
+    free(mask->walk_runs);
+    mask->walk_runs = NULL;
+    free(mask->block_index);
+    mask->block_index = NULL;
+    free(mask->block_runs);
+    mask->block_runs = NULL;
+    mask->w = 0;
+    mask->h = 0;
+    mask->pitch = 0;
 }
 
 /**
- * @brief Displays the door animation at the specified position.
- * @param bg The background structure.
+ * @brief Copies the visible window of an opaque background straight into the screen pixels.
+ * @param image The background, already in the screen's pixel format.
+ * @param cam_x The camera x-offset into the background.
+ * @param cam_y The camera y-offset into the background.
  * @param screen The SDL surface to render on.
+ * @return 1 if the rows were copied, 0 if the caller must fall back to SDL_BlitSurface.
+ */
+static int copy_background_rows(SDL_Surface *image, int cam_x, int cam_y, SDL_Surface *screen) {
+    // Only for a software screen with the exact same format and no transparency to honour;
+    // video memory is better served by SDL's accelerated blit. SDL_SRCALPHA alone does not
+    // count: with no alpha channel and a surface alpha of 255 the blit is a plain copy too.
+    if (image == NULL || (screen->flags & SDL_HWSURFACE) || (image->flags & SDL_SRCCOLORKEY) ||
+        ((image->flags & SDL_SRCALPHA) && (image->format->alpha != SDL_ALPHA_OPAQUE || image->format->Amask)) ||
+        image->format->BitsPerPixel != screen->format->BitsPerPixel ||
+        image->format->Rmask != screen->format->Rmask ||
+        image->format->Gmask != screen->format->Gmask ||
+        image->format->Bmask != screen->format->Bmask ||
+        cam_x < 0 || cam_y < 0) {
+        return 0;
+    }
+
+    int bpp = screen->format->BytesPerPixel;
+    int w = image->w - cam_x < screen->w ? image->w - cam_x : screen->w;
+    int h = image->h - cam_y < screen->h ? image->h - cam_y : screen->h;
+    if (w <= 0 || h <= 0) {
+        return 0;
+    }
+
+    if (SDL_MUSTLOCK(screen) && SDL_LockSurface(screen) < 0) {
+        return 0;
+    }
+    const Uint8 *src = (const Uint8 *)image->pixels + cam_y * image->pitch + cam_x * bpp;
+    Uint8 *dst = (Uint8 *)screen->pixels;
+    for (int y = 0; y < h; y++) {
+        memcpy(dst, src, (size_t)w * bpp);
+        src += image->pitch;
+        dst += screen->pitch;
+    }
+    if (SDL_MUSTLOCK(screen)) {
+        SDL_UnlockSurface(screen);
+    }
+    return 1;
+}
+
+/**
+ * @brief Displays the background on the screen with scrolling effect, and queues the door.
+ * @param bg Pointer to the background structure (read only).
+ * @param ctx Render context (screen, camera and draw list).
+ * @return Nothing.
+ */
+void display_background(const Background *bg, RenderCtx *ctx) {
+    SDL_Surface *screen = ctx->screen;
+    SDL_Surface *current_image = (bg->level == 1) ? bg->image_level1 : bg->image_level2;
+
+    if (!copy_background_rows(current_image, bg->camera.x, bg->camera.y, screen)) {
+        SDL_Rect src = {bg->camera.x, bg->camera.y, screen->w, screen->h}; // Scroll based on camera
+        SDL_Rect dst = {0, 0, screen->w, screen->h};                     // Destination on screen
+        SDL_BlitSurface(current_image, &src, screen, &dst);
+    }
+    display_door(bg, ctx); // Queued first: drawn under the enemies and players
+}
+
+/**
+ * @brief Queues the current door frame at its world position.
+ * @param bg Pointer to the background structure (read only).
+ * @param ctx Render context (screen, camera and draw list).
  * @return Nothing.
  */
-void display_door(Background bg, SDL_Surface *screen) {
+void display_door(const Background *bg, RenderCtx *ctx) {
     SDL_Surface *current_door_image = NULL;
-    SDL_Rect door_pos;
+    const SDL_Rect *door_pos = NULL;
     
-    if (bg.level == 1 && bg.door_frame >= 0 && bg.door_frame < 6) {
-        current_door_image = bg.door_images[bg.door_frame];
-        door_pos = bg.door_position;
-    } else if (bg.level == 2 && bg.door_frame >= 0 && bg.door_frame < 6) {
-        current_door_image = bg.door_images_level2[bg.door_frame];
-        door_pos = bg.door_position_level2;
+    if (bg->level == 1 && bg->door_frame >= 0 && bg->door_frame < 6) {
+        current_door_image = bg->door_images[bg->door_frame];
+        door_pos = &bg->door_position;
+    } else if (bg->level == 2 && bg->door_frame >= 0 && bg->door_frame < 6) {
+        current_door_image = bg->door_images_level2[bg->door_frame];
+        door_pos = &bg->door_position_level2;
     }
 
     if (current_door_image != NULL) {
-        door_pos.x -= bg.camera.x; // Adjust for camera scrolling
-        door_pos.y -= bg.camera.y;
-        SDL_BlitSurface(current_door_image, NULL, screen, &door_pos);
-        printf("Displaying door frame %d for level %d at x=%d, y=%d\n", bg.door_frame + 1, bg.level, door_pos.x, door_pos.y);
+        draw_sprite_world(ctx, current_door_image, NULL, door_pos); // The camera transform is applied there
+        LOG_TRACE("Displaying door frame %d for level %d at x=%d, y=%d\n", bg->door_frame + 1, bg->level, door_pos->x, door_pos->y);
     } else {
-        printf("Failed to display door: level=%d, frame=%d\n", bg.level, bg.door_frame);
+        LOG_ERROR("Failed to display door: level=%d, frame=%d\n", bg->level, bg->door_frame);
     }
 }
 
@@ -167,7 +429,7 @@ void update_door_animation(Background *bg) {
     if (bg->door_anim_stopped || bg->level != 1) {
         return; // Skip animation if stopped or not in level 1
     }
-    Uint32 t_now = SDL_GetTicks();
+    Uint32 t_now = input_ticks();
     Uint32 elapsed = t_now - bg->door_anim_start_time;
     bg->door_frame = (elapsed / 150) % 6; // 150ms per frame, cycle through 6 frames
 }
@@ -181,7 +443,7 @@ void update_door_animation_level2(Background *bg) {
     if (bg->door_anim_stopped || bg->level != 2) {
         return; // Skip animation if stopped or not in level 2
     }
-    Uint32 t_now = SDL_GetTicks();
+    Uint32 t_now = input_ticks();
     Uint32 elapsed = t_now - bg->door_anim_start_time;
     bg->door_frame = (elapsed / 150) % 6; // 150ms per frame, cycle through 6 frames
 }
@@ -196,7 +458,7 @@ void update_door_animation_level2(Background *bg) {
 void set_door_position_level2(Background *bg, int x, int y) {
     bg->door_position_level2.x = x;
     bg->door_position_level2.y = y;
-    printf("Level 2 door position set to x=%d, y=%d\n", x, y);
+    LOG_INFO("Level 2 door position set to x=%d, y=%d\n", x, y);
 }
 
 /**
@@ -223,7 +485,7 @@ void update_camera(Background *bg, int player_x, SDL_Surface *screen) {
 
 /**
  * @brief Checks if the player is on a walkable surface, over a hole, or hitting an obstacle.
- * @param bg The background structure.
+ * @param bg Pointer to the background structure (read only).
  * @param player_x The player's x-coordinate in world space.
  * @param player_y The player's y-coordinate.
  * @param player_w The player's width in pixels.
@@ -234,95 +496,73 @@ void update_camera(Background *bg, int player_x, SDL_Surface *screen) {
  * @param platform_y Pointer to store the detected platform's y-coordinate (for snapping).
  * @return 1 if the player should fall (not on pink), 0 if on platform (pink).
  */
-int check_collision(Background bg, int player_x, int player_y, int player_w, int player_h, int *is_obstacle, int status, float vy, int *platform_y) {
+int check_collision(const Background *bg, int player_x, int player_y, int player_w, int player_h, int *is_obstacle, int status, float vy, int *platform_y) {
+    return check_collision_swept(bg, player_x, player_y, player_y, player_w, player_h, is_obstacle, status, vy, platform_y);
+}
+
+/**
+ * @brief Checks collision over the rows swept by the player's feet since the last move.
+ * @param bg Pointer to the background structure (read only).
+ * @param player_x The player's x-coordinate in world space.
+ * @param prev_y The player's y-coordinate before this move.
+ * @param player_y The player's y-coordinate after this move.
+ * @param player_w The player's width in pixels.
+ * @param player_h The player's height in pixels.
+ * @param is_obstacle Pointer to flag indicating if an obstacle was hit (1 if true).
+ * @param status The player's current status (STAT_SOL, STAT_AIR, etc.).
+ * @param vy The player's vertical velocity.
+ * @param platform_y Pointer to store the detected platform's y-coordinate (for snapping).
+ * @return 1 if the player should fall (not on pink), 0 if on platform (pink).
+ */
+int check_collision_swept(const Background *bg, int player_x, int prev_y, int player_y, int player_w, int player_h, int *is_obstacle, int status, float vy, int *platform_y) {
     *is_obstacle = 0; // Default: no obstacle
     *platform_y = -1; // Default: no platform detected
 
-    SDL_Surface *current_collision_map = (bg.level == 1) ? bg.collision_map_level1 : bg.collision_map_level2;
+    const CollisionMask *mask = (bg->level == 1) ? &bg->collision_level1 : &bg->collision_level2;
 
     // Ensure coordinates are within bounds
-    if (player_x < 0 || player_x + player_w > current_collision_map->w ||
-        player_y < 0 || player_y + player_h > current_collision_map->h) {
+    if (player_x < 0 || player_x + player_w > mask->w ||
+        player_y < 0 || player_y + player_h > mask->h) {
         return 1; // Out of bounds, fall
     }
 
-    // Check multiple points under the player's feet (left, center, right) over a range of y-coordinates
+    // Probe 5 pixels above and below the feet; when moving down, start from where the feet were
     int check_y_base = player_y + player_h - 1; // Bottom of player sprite
-    int y_range = 5; // Check 5 pixels above and below
+    int y_range = 5;
+    int y_from = (prev_y < player_y ? prev_y + player_h - 1 : check_y_base) - y_range;
+    int y_to = check_y_base + y_range;
+    if (y_from < 0) y_from = 0;
+    if (y_to > mask->h - 1) y_to = mask->h - 1;
+
     int points[] = {player_x + player_w / 4, player_x + player_w / 2, player_x + 3 * player_w / 4}; // Left, center, right
     int num_points = 3;
-    int on_pink = 0;
-    int hit_green = 0;
     int detected_platform_y = -1;
-
-    // Lock surface for pixel access
-    if (SDL_MUSTLOCK(current_collision_map)) {
-        SDL_LockSurface(current_collision_map);
+    int pink_point = -1;
+
+    // Highest platform under any point; on a tie the leftmost point wins
+    for (int i = 0; i < num_points; i++) {
+        int y = collision_first_walkable(mask, points[i], y_from, y_to);
+        if (y != -1 && (detected_platform_y == -1 || y < detected_platform_y)) {
+            detected_platform_y = y;
+            pink_point = i;
+        }
     }
 
-    for (int y_offset = -y_range; y_offset <= y_range; y_offset++) {
-        int check_y = check_y_base + y_offset;
-        if (check_y < 0 || check_y >= current_collision_map->h) continue;
-
+    // Green only counts above the platform (or on its row, for points probed before the pink one)
+    if (status != STAT_AIR || vy >= 0) { // Only die on green if not ascending
         for (int i = 0; i < num_points; i++) {
-            int check_x = points[i];
-            Uint32 pixel;
-            Uint8 r, g, b;
-
-            // Get pixel data
-            Uint8 *pixels = (Uint8 *)current_collision_map->pixels;
-            int bpp = current_collision_map->format->BytesPerPixel;
-            Uint8 *p = pixels + check_y * current_collision_map->pitch + check_x * bpp;
-            switch (bpp) {
-                case 1:
-                    pixel = *p;
-                    break;
-                case 2:
-                    pixel = *(Uint16 *)p;
-                    break;
-                case 3:
-                    if (SDL_BYTEORDER == SDL_BIG_ENDIAN) {
-                        pixel = p[0] << 16 | p[1] << 8 | p[2];
-                    } else {
-                        pixel = p[0] | p[1] << 8 | p[2] << 16;
-                    }
-                    break;
-                case 4:
-                    pixel = *(Uint32 *)p;
-                    break;
-                default:
-                    pixel = 0;
+            int limit = y_to;
+            if (pink_point != -1) {
+                limit = (i < pink_point) ? detected_platform_y : detected_platform_y - 1;
             }
-
-            SDL_GetRGB(pixel, current_collision_map->format, &r, &g, &b);
-
-            // Pink: #ff00de (255, 0, 222)
-            if (r == 255 && g == 0 && b == 222) {
-                on_pink = 1;
-                detected_platform_y = check_y; // Store the y-coordinate of the platform
-                break; // Found a platform, no need to check more points
-            }
-
-            // Green: #00ff0c (0, 255, 12)
-            if (r == 0 && g == 255 && b == 12) {
-                if (status != STAT_AIR || vy >= 0) { // Only die on green if not ascending
-                    hit_green = 1;
-                }
+            if (limit >= y_from && collision_first_obstacle(mask, points[i], y_from, limit) != -1) {
+                *is_obstacle = 1;
+                return 0; // Don't fall, but obstacle logic will handle death
             }
         }
-        if (on_pink) break; // Exit y-loop if we found a platform
-    }
-
-    if (SDL_MUSTLOCK(current_collision_map)) {
-        SDL_UnlockSurface(current_collision_map);
-    }
-
-    if (hit_green) {
-        *is_obstacle = 1;
-        return 0; // Don't fall, but obstacle logic will handle death
     }
 
-    if (on_pink) {
+    if (pink_point != -1) {
         *platform_y = detected_platform_y;
         return 0; // On platform, don't fall
     }
@@ -336,30 +576,6 @@ int check_collision(Background bg, int player_x, int player_y, int player_w, int
  * @return Nothing.
  */
 void free_background(Background *bg) {
-    if (bg->image_level1) {
-        SDL_FreeSurface(bg->image_level1);
-        bg->image_level1 = NULL;
-    }
-    if (bg->collision_map_level1) {
-        SDL_FreeSurface(bg->collision_map_level1);
-        bg->collision_map_level1 = NULL;
-    }
-    if (bg->image_level2) {
-        SDL_FreeSurface(bg->image_level2);
-        bg->image_level2 = NULL;
-    }
-    if (bg->collision_map_level2) {
-        SDL_FreeSurface(bg->collision_map_level2);
-        bg->collision_map_level2 = NULL;
-    }
-    for (int i = 0; i < 6; i++) {
-        if (bg->door_images[i]) {
-            SDL_FreeSurface(bg->door_images[i]);
-            bg->door_images[i] = NULL;
-        }
-        if (bg->door_images_level2[i]) {
-            SDL_FreeSurface(bg->door_images_level2[i]);
-            bg->door_images_level2[i] = NULL;
-        }
-    }
+    background_free_level(bg, 1);
+    background_free_level(bg, 2);
 }
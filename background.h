@@ -11,15 +11,54 @@
 
 #include <SDL/SDL.h>
 #include <SDL/SDL_image.h>
+#include "render.h"
+
+#define COLLISION_NONE 0      // Empty pixel (neither pink nor green)
+#define COLLISION_WALKABLE 1  // Pink pixel (#ff00de): platform surface
+#define COLLISION_OBSTACLE 2  // Green pixel (#00ff0c): deadly obstacle
+
+/**
+ * @brief Vertical run of same-class pixels in one column of the collision map.
+ */
+typedef struct {
+    Uint16 top;    // First y of the run
+    Uint16 bottom; // Last y of the run (inclusive)
+} SurfaceRun;
+
+/**
+ * @brief Collision map packed at 2 bits per pixel (4 pixels per byte),
+ *        with per-column tables of walkable and obstacle runs sorted by y.
+ */
+typedef struct {
+    Uint8 *bits;   // Packed COLLISION_* values, row-major
+    int w;         // Width in pixels
+    int h;         // Height in pixels
+    int pitch;     // Bytes per row ((w + 3) / 4)
+    int *walk_index;        // Column x owns walk_runs[walk_index[x] .. walk_index[x + 1] - 1]
+    SurfaceRun *walk_runs;  // Pink runs, column by column, top to bottom
+    int *block_index;       // Column x owns block_runs[block_index[x] .. block_index[x + 1] - 1]
+    SurfaceRun *block_runs; // Green runs, column by column, top to bottom
+} CollisionMask;
+
+/**
+ * @brief Reads one pixel class from a packed collision mask.
+ * @param mask The collision mask.
+ * @param x The x-coordinate (must be inside the mask).
+ * @param y The y-coordinate (must be inside the mask).
+ * @return COLLISION_NONE, COLLISION_WALKABLE or COLLISION_OBSTACLE.
+ */
+static inline int collision_mask_get(const CollisionMask *mask, int x, int y) {
+    return (mask->bits[y * mask->pitch + (x >> 2)] >> ((x & 3) << 1)) & 3;
+}
 
 /**
  * @brief Structure representing the background and its properties.
  */
 typedef struct {
     SDL_Surface *image_level1;          // Visual background for level 1
-    SDL_Surface *collision_map_level1;  // Collision map for level 1
+    CollisionMask collision_level1;     // Packed collision map for level 1
     SDL_Surface *image_level2;          // Visual background for level 2
-    SDL_Surface *collision_map_level2;  // Collision map for level 2
+    CollisionMask collision_level2;     // Packed collision map for level 2
     SDL_Surface *door_images[6];        // Door sprite sheet images for level 1 (porte1.png to porte6.png)
     SDL_Surface *door_images_level2[6]; // Door sprite sheet images for level 2 (prt1.png to prt6.png)
 
@@ -37,18 +76,72 @@ typedef struct {
 
 /**
  * @brief Initializes the background with image, collision map, and door sprites.
- * @param bg Pointer to the background structure.
+ *        Only level 1 is loaded; the others are loaded with background_load_level.
+ * @param bg Pointer to the background structure (zeroed).
  * @return 0 on success, -1 on failure.
  */
 int init_background(Background *bg);
 
 /**
- * @brief Displays the background on the screen, accounting for camera position.
- * @param bg The background structure.
- * @param screen The SDL surface to render on.
+ * @brief Loads the visual background, collision map and door sprites of one level.
+ *        Does nothing if the level is already resident.
+ * @param bg Pointer to the background structure.
+ * @param level The level (1 or 2).
+ * @return 0 on success, -1 on failure (nothing of the level stays loaded).
+ */
+int background_load_level(Background *bg, int level);
+
+/**
+ * @brief Releases the visual background, collision map and door sprites of one level.
+ * @param bg Pointer to the background structure.
+ * @param level The level (1 or 2).
  * @return Nothing.
  */
-void display_background(Background bg, SDL_Surface *screen);
+void background_free_level(Background *bg, int level);
+
+/**
+ * @brief Builds a packed collision mask from a pink/green collision map image.
+ * @param map The collision map surface (any pixel format).
+ * @param mask Pointer to the mask to fill.
+ * @return 0 on success, -1 on failure.
+ */
+int build_collision_mask(SDL_Surface *map, CollisionMask *mask);
+
+/**
+ * @brief Finds the first walkable (pink) y in a column, using binary search on the run table.
+ * @param mask The collision mask.
+ * @param x The column (must be inside the mask).
+ * @param y_from First y to consider.
+ * @param y_to Last y to consider (inclusive).
+ * @return The smallest walkable y in [y_from, y_to], or -1 if there is none.
+ */
+int collision_first_walkable(const CollisionMask *mask, int x, int y_from, int y_to);
+
+/**
+ * @brief Finds the first obstacle (green) y in a column, using binary search on the run table.
+ * @param mask The collision mask.
+ * @param x The column (must be inside the mask).
+ * @param y_from First y to consider.
+ * @param y_to Last y to consider (inclusive).
+ * @return The smallest obstacle y in [y_from, y_to], or -1 if there is none.
+ */
+int collision_first_obstacle(const CollisionMask *mask, int x, int y_from, int y_to);
+
+/**
+ * @brief Frees a packed collision mask.
+ * @param mask Pointer to the mask to free.
+ * @return Nothing.
+ */
+void free_collision_mask(CollisionMask *mask);
+
+/**
+ * @brief Displays the background on the screen, accounting for camera position,
+ *        and queues the door.
+ * @param bg Pointer to the background structure (read only).
+ * @param ctx Render context (screen, camera and draw list).
+ * @return Nothing.
+ */
+void display_background(const Background *bg, RenderCtx *ctx);
 
 /**
  * @brief Updates the camera position based on the player's x-coordinate.
@@ -61,7 +154,7 @@ void update_camera(Background *bg, int player_x, SDL_Surface *screen);
 
 /**
  * @brief Checks if the player is on a walkable surface, over a hole, or hitting an obstacle.
- * @param bg The background structure.
+ * @param bg Pointer to the background structure (read only).
  * @param player_x The player's x-coordinate in world space.
  * @param player_y The player's y-coordinate.
  * @param player_w The player's width in pixels.
@@ -72,15 +165,32 @@ void update_camera(Background *bg, int player_x, SDL_Surface *screen);
  * @param platform_y Pointer to store the detected platform's y-coordinate (for snapping).
  * @return 1 if the player should fall (not on pink), 0 if on platform (pink).
  */
-int check_collision(Background bg, int player_x, int player_y, int player_w, int player_h, int *is_obstacle, int status, float vy, int *platform_y);
+int check_collision(const Background *bg, int player_x, int player_y, int player_w, int player_h, int *is_obstacle, int status, float vy, int *platform_y);
+
+/**
+ * @brief Same as check_collision, but when moving down it also probes every row the feet
+ *        crossed since prev_y, so a fast fall cannot skip over a thin platform.
+ * @param bg Pointer to the background structure (read only).
+ * @param player_x The player's x-coordinate in world space.
+ * @param prev_y The player's y-coordinate before this move.
+ * @param player_y The player's y-coordinate after this move.
+ * @param player_w The player's width in pixels.
+ * @param player_h The player's height in pixels.
+ * @param is_obstacle Pointer to flag indicating if an obstacle was hit (1 if true).
+ * @param status The player's current status (STAT_SOL, STAT_AIR, etc.).
+ * @param vy The player's vertical velocity.
+ * @param platform_y Pointer to store the detected platform's y-coordinate (for snapping).
+ * @return 1 if the player should fall (not on pink), 0 if on platform (pink).
+ */
+int check_collision_swept(const Background *bg, int player_x, int prev_y, int player_y, int player_w, int player_h, int *is_obstacle, int status, float vy, int *platform_y);
 
 /**
- * @brief Displays the door animation at x=40.
- * @param bg The background structure.
- * @param screen The SDL surface to render on.
+ * @brief Queues the current door frame at its world position.
+ * @param bg Pointer to the background structure (read only).
+ * @param ctx Render context (screen, camera and draw list).
  * @return Nothing.
  */
-void display_door(Background bg, SDL_Surface *screen);
+void display_door(const Background *bg, RenderCtx *ctx);
 
 /**
  * @brief Updates the door animation frame for level 1.
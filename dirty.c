@@ -0,0 +1,148 @@
+/**
+ * @file dirty.c
+ * @brief Dirty-rectangle tracker and presentation with SDL_UpdateRects.
+ * @author MohamedNourMraad
+ * @date 2025-05-25
+ * @version 1.0
+ */
+
+#include <SDL/SDL.h>
+#include <string.h>
+#include "dirty.h"
+#include "log.h"
+
+static SDL_Rect rects[DIRTY_MAX];       // Regions changed in the frame being drawn
+static int rect_count = 0;
+static SDL_Rect previous[DIRTY_MAX];    // Regions changed in the previous frame (must be repaired too)
+static int previous_count = 0;
+static int full = 1;                    // The first frame is always a full flip
+static int overflow = 0;                // rects[] was full: the next frame cannot be repaired either
+static int camera_known = 0;
+static Sint16 camera_x = 0, camera_y = 0;
+
+void dirty_invalidate(void) {
+    full = 1;
+}
+
+void dirty_track_camera(const SDL_Rect *camera) {
+    if (!camera_known || camera->x != camera_x || camera->y != camera_y) {
+        full = 1;
+    }
+    camera_x = camera->x;
+    camera_y = camera->y;
+    camera_known = 1;
+}
+
+int dirty_full_pending(void) {
+    SDL_Surface *screen = SDL_GetVideoSurface();
+    return full || (screen != NULL && (screen->flags & SDL_DOUBLEBUF));
+}
+
+void dirty_add(const SDL_Rect *rect) {
+    if (overflow || rect->w == 0 || rect->h == 0) {
+        return;
+    }
+    if (rect_count > 0) {
+        SDL_Rect *last = &rects[rect_count - 1];
+        int x1 = rect->x < last->x ? rect->x : last->x;
+        int y1 = rect->y < last->y ? rect->y : last->y;
+        int x2 = rect->x + rect->w > last->x + last->w ? rect->x + rect->w : last->x + last->w;
+        int y2 = rect->y + rect->h > last->y + last->h ? rect->y + rect->h : last->y + last->h;
+        if (rect->x <= last->x + last->w + DIRTY_MERGE_GAP && last->x <= rect->x + rect->w + DIRTY_MERGE_GAP &&
+            rect->y <= last->y + last->h + DIRTY_MERGE_GAP && last->y <= rect->y + rect->h + DIRTY_MERGE_GAP) {
+            last->x = x1; // Touching the previous rect: grow it instead of adding one
+            last->y = y1;
+            last->w = x2 - x1;
+            last->h = y2 - y1;
+            return;
+        }
+    }
+    if (rect_count == DIRTY_MAX) {
+        overflow = 1;
+        full = 1;
+        return;
+    }
+    rects[rect_count++] = *rect;
+}
+
+int dirty_blit(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst, SDL_Rect *dstrect) {
+    int result = SDL_BlitSurface(src, srcrect, dst, dstrect);
+    if (result == 0 && dstrect != NULL && dst == SDL_GetVideoSurface()) {
+        dirty_add(dstrect); // SDL left the clipped rect in dstrect
+    } else if (result == 0 && dst == SDL_GetVideoSurface()) {
+        full = 1;
+    }
+    return result;
+}
+
+int dirty_fill(SDL_Surface *dst, SDL_Rect *rect, Uint32 color) {
+    int result = SDL_FillRect(dst, rect, color);
+    if (result == 0 && dst == SDL_GetVideoSurface()) {
+        if (rect != NULL) {
+            dirty_add(rect);
+        } else {
+            full = 1;
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Clips a rect to the screen.
+ * @param r The rect to clip.
+ * @param screen The video surface.
+ * @return 1 if something is left, 0 if the rect is off screen.
+ */
+static int clip_to_screen(SDL_Rect *r, const SDL_Surface *screen) {
+    int x1 = r->x < 0 ? 0 : r->x;
+    int y1 = r->y < 0 ? 0 : r->y;
+    int x2 = r->x + r->w > screen->w ? screen->w : r->x + r->w;
+    int y2 = r->y + r->h > screen->h ? screen->h : r->y + r->h;
+    if (x2 <= x1 || y2 <= y1) {
+        return 0;
+    }
+    r->x = x1;
+    r->y = y1;
+    r->w = x2 - x1;
+    r->h = y2 - y1;
+    return 1;
+}
+
+void dirty_present(SDL_Surface *screen) {
+    SDL_Rect update[2 * DIRTY_MAX];
+    int count = 0;
+    long area = 0;
+
+    if (!full && !(screen->flags & SDL_DOUBLEBUF)) {
+        // A region drawn last frame may have been vacated this frame: update both
+        for (int i = 0; i < previous_count + rect_count; i++) {
+            SDL_Rect r = i < previous_count ? previous[i] : rects[i - previous_count];
+            if (clip_to_screen(&r, screen)) {
+                area += (long)r.w * r.h;
+                update[count++] = r;
+            }
+        }
+    }
+
+    if (full || (screen->flags & SDL_DOUBLEBUF) || area * DIRTY_FULL_RATIO > (long)screen->w * screen->h) {
+        SDL_Flip(screen);
+        LOG_TRACE("Présentation : écran complet\n");
+    } else if (count > 0) {
+        SDL_UpdateRects(screen, count, update);
+        LOG_TRACE("Présentation : %d rectangles, %ld pixels\n", count, area);
+    }
+
+    memcpy(previous, rects, sizeof(SDL_Rect) * rect_count);
+    previous_count = rect_count;
+    rect_count = 0;
+    full = overflow; // Regions of an overflowed frame are unknown, so the next one is full too
+    overflow = 0;
+}
+
+void dirty_flip(SDL_Surface *screen) {
+    SDL_Flip(screen);
+    rect_count = 0;
+    previous_count = 0;
+    overflow = 0;
+    full = 1;
+}
@@ -0,0 +1,84 @@
+/**
+ * @file dirty.h
+ * @brief Dirty-rectangle presentation: changed screen regions are recorded while
+ *        drawing and presented with SDL_UpdateRects; full flips only when the whole
+ *        screen changed (camera moved, new screen, double-buffered video surface).
+ * @author MohamedNourMraad
+ * @date 2025-05-25
+ * @version 1.0
+ */
+
+#ifndef DIRTY_H
+#define DIRTY_H
+
+#include <SDL/SDL.h>
+
+#define DIRTY_MAX 128        // Rects per frame; more falls back to a full flip
+#define DIRTY_MERGE_GAP 8    // A rect this close to the previous one is merged into it (text glyphs)
+#define DIRTY_FULL_RATIO 2   // Updating more than 1/2 of the screen is done with a full flip
+
+/**
+ * @brief Makes the next present a full flip. Screens that keep their static parts
+ *        (see dirty_full_pending) redraw everything for that frame.
+ * @return Nothing.
+ */
+void dirty_invalidate(void);
+
+/**
+ * @brief Invalidates the screen when the camera moved since the previous call.
+ * @param camera The camera of the frame being drawn (only x and y are compared).
+ * @return Nothing.
+ */
+void dirty_track_camera(const SDL_Rect *camera);
+
+/**
+ * @brief Tells whether the frame being drawn will be presented as a full flip,
+ *        i.e. whether static parts must be redrawn. Always true on a double-buffered
+ *        video surface, whose back buffer holds an older frame.
+ * @return 1 if everything must be drawn, 0 if only changed regions are needed.
+ */
+int dirty_full_pending(void);
+
+/**
+ * @brief Records a changed screen region.
+ * @param rect The region in screen coordinates (clipped when presented).
+ * @return Nothing.
+ */
+void dirty_add(const SDL_Rect *rect);
+
+/**
+ * @brief SDL_BlitSurface that records the blitted region when drawing on the screen.
+ * @param src The source surface.
+ * @param srcrect The part of the source, or NULL for all of it.
+ * @param dst The destination surface.
+ * @param dstrect The destination position (receives the clipped rect, like SDL_BlitSurface).
+ * @return The result of SDL_BlitSurface.
+ */
+int dirty_blit(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst, SDL_Rect *dstrect);
+
+/**
+ * @brief SDL_FillRect that records the filled region when drawing on the screen.
+ * @param dst The destination surface.
+ * @param rect The rect to fill (receives the clipped rect), or NULL for the whole surface.
+ * @param color The color, mapped to the surface format.
+ * @return The result of SDL_FillRect.
+ */
+int dirty_fill(SDL_Surface *dst, SDL_Rect *rect, Uint32 color);
+
+/**
+ * @brief Presents the frame: the regions recorded in this frame and the previous one
+ *        with SDL_UpdateRects, or a full flip if the screen was invalidated.
+ * @param screen The video surface.
+ * @return Nothing.
+ */
+void dirty_present(SDL_Surface *screen);
+
+/**
+ * @brief Full flip for screens that do not track their changes. The next present
+ *        is a full flip too, since the screen no longer shows what the tracker expects.
+ * @param screen The video surface.
+ * @return Nothing.
+ */
+void dirty_flip(SDL_Surface *screen);
+
+#endif // DIRTY_H
@@ -1,8 +1,12 @@
 #include "enigme.h"
+#include "assets.h"
+#include "dirty.h"
+#include "log.h"
+#include "sfx.h"
+#include "input.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <time.h>
 #include <errno.h>
 
 void load_questions(enigme *e, const char *q_file, const char *a_file, const char *c_file) {
@@ -12,7 +16,7 @@ void load_questions(enigme *e, const char *q_file, const char *a_file, const cha
 
     FILE *q_fp = fopen(q_file, "r");
     if (!q_fp) {
-        printf("Error opening %s: %s\n", q_file, strerror(errno));
+        LOG_ERROR("Error opening %s: %s\n", q_file, strerror(errno));
         exit(1);
     }
     
@@ -26,20 +30,20 @@ void load_questions(enigme *e, const char *q_file, const char *a_file, const cha
     fclose(q_fp);
 
     if (e->nb_questions == 0) {
-        printf("Error: No questions loaded from %s\n", q_file);
+        LOG_ERROR("Error: No questions loaded from %s\n", q_file);
         exit(1);
     }
 
     FILE *a_fp = fopen(a_file, "r");
     if (!a_fp) {
-        printf("Error opening %s: %s\n", a_file, strerror(errno));
+        LOG_ERROR("Error opening %s: %s\n", a_file, strerror(errno));
         exit(1);
     }
 
     for (int i = 0; i < e->nb_questions; i++) {
         for (int j = 0; j < NB_REPONSES; j++) {
             if (!fgets(line, sizeof(line), a_fp)) {
-                printf("Error: Not enough answers in %s\n", a_file);
+                LOG_ERROR("Error: Not enough answers in %s\n", a_file);
                 exit(1);
             }
             strncpy(e->reponses[i][j], line, sizeof(e->reponses[0][0]) - 1);
@@ -50,18 +54,18 @@ void load_questions(enigme *e, const char *q_file, const char *a_file, const cha
 
     FILE *c_fp = fopen(c_file, "r");
     if (!c_fp) {
-        printf("Error opening %s: %s\n", c_file, strerror(errno));
+        LOG_ERROR("Error opening %s: %s\n", c_file, strerror(errno));
         exit(1);
     }
 
     for (int i = 0; i < e->nb_questions; i++) {
         if (!fgets(line, sizeof(line), c_fp)) {
-            printf("Error: Not enough correct answers in %s\n", c_file);
+            LOG_ERROR("Error: Not enough correct answers in %s\n", c_file);
             exit(1);
         }
         e->correct_answers[i] = atoi(line);
         if (e->correct_answers[i] < 0 || e->correct_answers[i] >= NB_REPONSES) {
-            printf("Error: Invalid correct answer %d for question %d\n", e->correct_answers[i], i);
+            LOG_ERROR("Error: Invalid correct answer %d for question %d\n", e->correct_answers[i], i);
             exit(1);
         }
     }
@@ -78,41 +82,23 @@ void initialiser_enigme(enigme *e) {
     e->level = 1;
     e->temps_restant = TEMPS_PAR_QUESTION;
     e->questions_answered = 0;
-    srand(time(NULL));
+    srand(input_seed()); // Same questions when a session is replayed
 
-    e->background = IMG_Load("ques.png");
+    asset_load(&e->background, "ques.png");
     if (!e->background) {
-        printf("Failed to load background: %s\n", IMG_GetError());
+        LOG_ERROR("Failed to load background: %s\n", IMG_GetError());
         exit(1);
     }
 
-    e->button = IMG_Load("but3.png");
+    asset_load(&e->button, "but3.png");
     if (!e->button) {
-        printf("Failed to load button: %s\n", IMG_GetError());
+        LOG_ERROR("Failed to load button: %s\n", IMG_GetError());
         exit(1);
     }
 
-    e->button_s = IMG_Load("but-s.png");
+    asset_load(&e->button_s, "but-s.png");
     if (!e->button_s) {
-        printf("Failed to load button_s: %s\n", IMG_GetError());
-        exit(1);
-    }
-
-    e->sound = Mix_LoadWAV("clic.wav");
-    if (!e->sound) {
-        printf("Failed to load sound: %s\n", Mix_GetError());
-        exit(1);
-    }
-
-    e->correct_sound = Mix_LoadWAV("correct.wav");
-    if (!e->correct_sound) {
-        printf("Failed to load correct_sound: %s\n", Mix_GetError());
-        exit(1);
-    }
-
-    e->wrong_sound = Mix_LoadWAV("wrong.wav");
-    if (!e->wrong_sound) {
-        printf("Failed to load wrong_sound: %s\n", Mix_GetError());
+        LOG_ERROR("Failed to load button_s: %s\n", IMG_GetError());
         exit(1);
     }
 
@@ -148,12 +134,12 @@ void initialiser_enigme(enigme *e) {
 
 void generer_enigme(enigme *e, int question_index, TTF_Font *font) {
     if (!e || !font || question_index < 0 || question_index >= e->nb_questions) {
-        printf("Invalid enigma, font, or question index: %d\n", question_index);
+        LOG_ERROR("Invalid enigma, font, or question index: %d\n", question_index);
         return;
     }
 
     e->pos_selected = 0;
-    e->temps_debut = SDL_GetTicks();
+    e->temps_debut = input_ticks();
     e->temps_restant = TEMPS_PAR_QUESTION - (e->level - 1) * 2;
     if (e->temps_restant < 10) e->temps_restant = 10;
     e->num_question = question_index;
@@ -167,7 +153,7 @@ void generer_enigme(enigme *e, int question_index, TTF_Font *font) {
     }
     e->question = TTF_RenderText_Solid(font, e->questions[question_index], couleur);
     if (!e->question) {
-        printf("Failed to render question: %s\n", TTF_GetError());
+        LOG_ERROR("Failed to render question: %s\n", TTF_GetError());
         return;
     }
 
@@ -178,7 +164,7 @@ void generer_enigme(enigme *e, int question_index, TTF_Font *font) {
         }
         e->reponses_surface[i] = TTF_RenderText_Solid(font, e->reponses[question_index][i], couleur);
         if (!e->reponses_surface[i]) {
-            printf("Failed to render answer %d: %s\n", i, TTF_GetError());
+            LOG_ERROR("Failed to render answer %d: %s\n", i, TTF_GetError());
             if (e->question) {
                 SDL_FreeSurface(e->question);
                 e->question = NULL;
@@ -203,7 +189,7 @@ void generer_enigme(enigme *e, int question_index, TTF_Font *font) {
     }
     e->score_surface = TTF_RenderText_Solid(font, score_text, couleur);
     if (!e->score_surface) {
-        printf("Failed to render score: %s\n", TTF_GetError());
+        LOG_ERROR("Failed to render score: %s\n", TTF_GetError());
         if (e->question) {
             SDL_FreeSurface(e->question);
             e->question = NULL;
@@ -223,7 +209,7 @@ void generer_enigme(enigme *e, int question_index, TTF_Font *font) {
     }
     e->level_surface = TTF_RenderText_Solid(font, level_text, couleur);
     if (!e->level_surface) {
-        printf("Failed to render level: %s\n", TTF_GetError());
+        LOG_ERROR("Failed to render level: %s\n", TTF_GetError());
         if (e->question) {
             SDL_FreeSurface(e->question);
             e->question = NULL;
@@ -242,13 +228,10 @@ void generer_enigme(enigme *e, int question_index, TTF_Font *font) {
     }
 
     for (int i = 0; i < MAX_VIES; i++) {
-        if (e->vies_surface[i]) {
-            SDL_FreeSurface(e->vies_surface[i]);
-            e->vies_surface[i] = NULL;
-        }
-        e->vies_surface[i] = (i < e->vies) ? IMG_Load("vie.png") : IMG_Load("vie_vide.png");
+        // Reloading into the slot releases the previous heart; all hearts share one surface
+        asset_load(&e->vies_surface[i], (i < e->vies) ? "vie.png" : "vie_vide.png");
         if (!e->vies_surface[i]) {
-            printf("Failed to load life image %d: %s\n", i, IMG_GetError());
+            LOG_ERROR("Failed to load life image %d: %s\n", i, IMG_GetError());
             if (e->question) {
                 SDL_FreeSurface(e->question);
                 e->question = NULL;
@@ -269,7 +252,7 @@ void generer_enigme(enigme *e, int question_index, TTF_Font *font) {
             }
             for (int j = 0; j < i; j++) {
                 if (e->vies_surface[j]) {
-                    SDL_FreeSurface(e->vies_surface[j]);
+                    asset_free(&e->vies_surface[j]);
                     e->vies_surface[j] = NULL;
                 }
             }
@@ -277,27 +260,48 @@ void generer_enigme(enigme *e, int question_index, TTF_Font *font) {
         }
     }
 
-    printf("Enigma generated successfully for question %d\n", question_index);
+    LOG_DEBUG("Enigma generated successfully for question %d\n", question_index);
+}
+
+/**
+ * @brief Repaints the background under a region before it is drawn again.
+ * @param e The enigma (background).
+ * @param ecran The SDL surface to render on.
+ * @param area The region in screen coordinates.
+ * @return Nothing.
+ */
+static void restaurer_fond(const enigme *e, SDL_Surface *ecran, const SDL_Rect *area) {
+    SDL_Rect src = *area;
+    SDL_Rect dst = *area;
+    if (e->background) {
+        dirty_blit(e->background, &src, ecran, &dst); // The background is drawn at (0, 0)
+    } else {
+        dirty_fill(ecran, &dst, SDL_MapRGB(ecran->format, 0, 0, 0));
+    }
 }
 
 void afficher_enigme(enigme *e, SDL_Surface *ecran, int souris_x, int souris_y) {
     if (!e || !ecran) {
-        printf("Error: Null enigma or screen in afficher_enigme\n");
+        LOG_ERROR("Error: Null enigma or screen in afficher_enigme\n");
         return;
     }
 
-    SDL_FillRect(ecran, NULL, SDL_MapRGB(ecran->format, 0, 0, 0));
+    // Between two questions only the buttons (hover) and the timer bar change
+    int complet = dirty_full_pending();
+    if (complet) {
+        SDL_FillRect(ecran, NULL, SDL_MapRGB(ecran->format, 0, 0, 0));
 
-    if (e->background) {
-        SDL_BlitSurface(e->background, NULL, ecran, NULL);
-    } else {
-        printf("Warning: Background surface is null\n");
-    }
+        if (e->background) {
+            SDL_BlitSurface(e->background, NULL, ecran, NULL);
+        } else {
+            LOG_WARN("Warning: Background surface is null\n");
+        }
 
-    if (e->question) {
-        SDL_BlitSurface(e->question, NULL, ecran, &e->pos_question);
-    } else {
-        printf("Warning: Question surface is null\n");
+        if (e->question) {
+            SDL_BlitSurface(e->question, NULL, ecran, &e->pos_question);
+        } else {
+            LOG_WARN("Warning: Question surface is null\n");
+        }
     }
 
     int hover_button = -1;
@@ -313,7 +317,7 @@ void afficher_enigme(enigme *e, SDL_Surface *ecran, int souris_x, int souris_y)
             hover_button = 3;
         }
     } else {
-        printf("Warning: Button or selected button surface is null\n");
+        LOG_WARN("Warning: Button or selected button surface is null\n");
     }
 
     SDL_Surface *buttons[3] = {NULL};
@@ -322,42 +326,52 @@ void afficher_enigme(enigme *e, SDL_Surface *ecran, int souris_x, int souris_y)
         buttons[1] = (hover_button == 2) ? e->button_s : e->button;
         buttons[2] = (hover_button == 3) ? e->button_s : e->button;
 
-        if (buttons[0]) SDL_BlitSurface(buttons[0], NULL, ecran, &e->pos_reponse1);
-        if (buttons[1]) SDL_BlitSurface(buttons[1], NULL, ecran, &e->pos_reponse2);
-        if (buttons[2]) SDL_BlitSurface(buttons[2], NULL, ecran, &e->pos_reponse3);
+        SDL_Rect *pos_boutons[3] = {&e->pos_reponse1, &e->pos_reponse2, &e->pos_reponse3};
+        SDL_Rect pos;
+        for (int i = 0; i < 3; i++) {
+            // Both images may differ in size: repaint the area of the larger one first
+            SDL_Rect zone = {pos_boutons[i]->x, pos_boutons[i]->y,
+                             e->button->w > e->button_s->w ? e->button->w : e->button_s->w,
+                             e->button->h > e->button_s->h ? e->button->h : e->button_s->h};
+            if (!complet) restaurer_fond(e, ecran, &zone);
+            pos = *pos_boutons[i];
+            dirty_blit(buttons[i], NULL, ecran, &pos);
+        }
     }
 
     for (int i = 0; i < NB_REPONSES; i++) {
         if (e->reponses_surface[i]) {
-            SDL_Rect *pos = (i == 0) ? &e->pos_reponse1txt : (i == 1) ? &e->pos_reponse2txt : &e->pos_reponse3txt;
-            SDL_BlitSurface(e->reponses_surface[i], NULL, ecran, pos);
+            SDL_Rect pos = (i == 0) ? e->pos_reponse1txt : (i == 1) ? e->pos_reponse2txt : e->pos_reponse3txt;
+            dirty_blit(e->reponses_surface[i], NULL, ecran, &pos);
         } else {
-            printf("Warning: Response surface %d is null\n", i);
+            LOG_WARN("Warning: Response surface %d is null\n", i);
         }
     }
 
-    for (int i = 0; i < MAX_VIES; i++) {
-        if (e->vies_surface[i]) {
-            SDL_BlitSurface(e->vies_surface[i], NULL, ecran, &e->pos_vies[i]);
-        } else {
-            printf("Warning: Life surface %d is null\n", i);
+    if (complet) {
+        for (int i = 0; i < MAX_VIES; i++) {
+            if (e->vies_surface[i]) {
+                SDL_BlitSurface(e->vies_surface[i], NULL, ecran, &e->pos_vies[i]);
+            } else {
+                LOG_WARN("Warning: Life surface %d is null\n", i);
+            }
         }
-    }
 
-    if (e->score_surface) {
-        SDL_BlitSurface(e->score_surface, NULL, ecran, &e->pos_score);
-    } else {
-        printf("Warning: Score surface is null\n");
-    }
+        if (e->score_surface) {
+            SDL_BlitSurface(e->score_surface, NULL, ecran, &e->pos_score);
+        } else {
+            LOG_WARN("Warning: Score surface is null\n");
+        }
 
-    if (e->level_surface) {
-        SDL_BlitSurface(e->level_surface, NULL, ecran, &e->pos_level);
-    } else {
-        printf("Warning: Level surface is null\n");
+        if (e->level_surface) {
+            SDL_BlitSurface(e->level_surface, NULL, ecran, &e->pos_level);
+        } else {
+            LOG_WARN("Warning: Level surface is null\n");
+        }
     }
 
     SDL_Rect timer_border = {e->pos_timer.x, e->pos_timer.y, 150, 20};
-    SDL_FillRect(ecran, &timer_border, SDL_MapRGB(ecran->format, 255, 255, 255));
+    dirty_fill(ecran, &timer_border, SDL_MapRGB(ecran->format, 255, 255, 255));
 
     float time_ratio = (float)e->temps_restant / TEMPS_PAR_QUESTION;
     int fill_width = (int)(148 * time_ratio);
@@ -367,10 +381,10 @@ void afficher_enigme(enigme *e, SDL_Surface *ecran, int souris_x, int souris_y)
     Uint8 r = (Uint8)(255 * (1 - time_ratio));
     Uint8 g = (Uint8)(255 * time_ratio);
     SDL_Rect timer_fill = {e->pos_timer.x + 1, e->pos_timer.y + 1, fill_width, 18};
-    SDL_FillRect(ecran, &timer_fill, SDL_MapRGB(ecran->format, r, g, 0));
+    SDL_FillRect(ecran, &timer_fill, SDL_MapRGB(ecran->format, r, g, 0)); // Inside the border
 
-    SDL_Flip(ecran);
-    printf("Enigma displayed successfully\n");
+    dirty_present(ecran);
+    LOG_TRACE("Enigma displayed successfully\n");
 }
 
 int verify_enigme(enigme *e, SDL_Surface *ecran) {
@@ -378,17 +392,17 @@ int verify_enigme(enigme *e, SDL_Surface *ecran) {
 
     if (e->correct_answers[e->num_question] == e->pos_selected - 1) {
         e->score += 10 * e->level;
-        if (e->correct_sound) Mix_PlayChannel(-1, e->correct_sound, 0);
+        sfx_play(SFX_CORRECT);
         return 1;
     } else {
         e->vies--;
-        if (e->wrong_sound) Mix_PlayChannel(-1, e->wrong_sound, 0);
+        sfx_play(SFX_WRONG);
         return 0;
     }
 }
 
 void mettre_a_jour_timer(enigme *e) {
-    Uint32 temps_ecoule = SDL_GetTicks() - e->temps_debut;
+    Uint32 temps_ecoule = input_ticks() - e->temps_debut;
     e->temps_restant = (TEMPS_PAR_QUESTION - (e->level - 1) * 2) - (temps_ecoule / 1000);
     if (e->temps_restant <= 0) {
         e->temps_restant = 0;
@@ -398,7 +412,7 @@ void mettre_a_jour_timer(enigme *e) {
 
 void afficher_resultat(SDL_Surface *ecran, int correct, enigme *e, TTF_Font *font) {
     if (!ecran || !e || !font) {
-        printf("Error: Null screen, enigma, or font in afficher_resultat\n");
+        LOG_ERROR("Error: Null screen, enigma, or font in afficher_resultat\n");
         return;
     }
 
@@ -410,61 +424,58 @@ void afficher_resultat(SDL_Surface *ecran, int correct, enigme *e, TTF_Font *fon
         SDL_Rect pos = {(SCREEN_WIDTH - resultat->w) / 2, (SCREEN_HEIGHT - resultat->h) / 2};
         SDL_FillRect(ecran, NULL, SDL_MapRGB(ecran->format, 0, 0, 0));
         SDL_BlitSurface(resultat, NULL, ecran, &pos);
-        SDL_Flip(ecran);
+        dirty_flip(ecran);
+        sfx_dispatch(input_ticks()); // The click and the verdict must not wait for the delay
         SDL_Delay(1000);
         SDL_FreeSurface(resultat);
     } else {
-        printf("Failed to render result text: %s\n", TTF_GetError());
+        LOG_ERROR("Failed to render result text: %s\n", TTF_GetError());
     }
 
-    printf("Result displayed: %s\n", message);
+    LOG_DEBUG("Result displayed: %s\n", message);
 }
 
 void free_enigme(enigme *e) {
-    if (e->background) SDL_FreeSurface(e->background);
+    asset_free(&e->background);
     if (e->question) SDL_FreeSurface(e->question);
     
     for (int i = 0; i < NB_REPONSES; i++) {
         if (e->reponses_surface[i]) SDL_FreeSurface(e->reponses_surface[i]);
     }
     
-    if (e->button) SDL_FreeSurface(e->button);
-    if (e->button_s) SDL_FreeSurface(e->button_s);
+    asset_free(&e->button);
+    asset_free(&e->button_s);
     
     for (int i = 0; i < MAX_VIES; i++) {
-        if (e->vies_surface[i]) SDL_FreeSurface(e->vies_surface[i]);
+        if (e->vies_surface[i]) asset_free(&e->vies_surface[i]);
     }
     
     if (e->score_surface) SDL_FreeSurface(e->score_surface);
     if (e->level_surface) SDL_FreeSurface(e->level_surface);
-    
-    if (e->sound) Mix_FreeChunk(e->sound);
-    if (e->correct_sound) Mix_FreeChunk(e->correct_sound);
-    if (e->wrong_sound) Mix_FreeChunk(e->wrong_sound);
 }
 
 int afficher_ecran_accueil(SDL_Surface *ecran) {
     if (!ecran) {
-        printf("Error: Screen surface is NULL\n");
+        LOG_ERROR("Error: Screen surface is NULL\n");
         return -1;
     }
 
-    printf("Screen: w=%d, h=%d\n", SCREEN_WIDTH, SCREEN_HEIGHT);
+    LOG_DEBUG("Screen: w=%d, h=%d\n", SCREEN_WIDTH, SCREEN_HEIGHT);
 
-    SDL_Surface *bg = IMG_Load("bg.png");
+    SDL_Surface *bg = asset_load_image("bg.png");
     if (!bg) {
-        printf("Failed to load bg.png: %s\n", IMG_GetError());
+        LOG_ERROR("Failed to load bg.png: %s\n", IMG_GetError());
         return -1;
     }
-    SDL_Surface *quizz = IMG_Load("quizz.png");
+    SDL_Surface *quizz = asset_load_image("quizz.png");
     if (!quizz) {
-        printf("Failed to load quizz.png: %s\n", IMG_GetError());
+        LOG_ERROR("Failed to load quizz.png: %s\n", IMG_GetError());
         SDL_FreeSurface(bg);
         return -1;
     }
-    SDL_Surface *puz = IMG_Load("puz.png");
+    SDL_Surface *puz = asset_load_image("puz.png");
     if (!puz) {
-        printf("Failed to load puz.png: %s\n", IMG_GetError());
+        LOG_ERROR("Failed to load puz.png: %s\n", IMG_GetError());
         SDL_FreeSurface(bg);
         SDL_FreeSurface(quizz);
         return -1;
@@ -487,64 +498,67 @@ int afficher_ecran_accueil(SDL_Surface *ecran) {
     int puz_click_h = puz->h;
 
     // Log clickable areas
-    printf("Clickable areas:\n");
-    printf("  quizz: x=%d to %d, y=%d to %d\n", quizz_click_x, quizz_click_x + quizz_click_w, 
+    LOG_DEBUG("Clickable areas:\n");
+    LOG_DEBUG("  quizz: x=%d to %d, y=%d to %d\n", quizz_click_x, quizz_click_x + quizz_click_w, 
            quizz_click_y, quizz_click_y + quizz_click_h);
-    printf("  puz: x=%d to %d, y=%d to %d\n", puz_click_x, puz_click_x + puz_click_w, 
+    LOG_DEBUG("  puz: x=%d to %d, y=%d to %d\n", puz_click_x, puz_click_x + puz_click_w, 
            puz_click_y, puz_click_y + puz_click_h);
 
     // Render screen
+    dirty_invalidate();
     SDL_FillRect(ecran, NULL, SDL_MapRGB(ecran->format, 0, 0, 0));
     SDL_BlitSurface(bg, NULL, ecran, &pos_bg);
     SDL_BlitSurface(quizz, NULL, ecran, &pos_quizz);
     SDL_BlitSurface(puz, NULL, ecran, &pos_puz);
-    SDL_Flip(ecran);
-    printf("Screen rendered\n");
+    dirty_present(ecran);
+    LOG_DEBUG("Screen rendered\n");
 
     // Event loop
     int choice = 0;
     SDL_Event event;
     while (choice == 0) {
-        while (SDL_PollEvent(&event)) {
+        while (input_poll_event(&event)) {
             if (event.type == SDL_MOUSEMOTION) {
-                printf("Mouse at x=%d, y=%d\n", event.motion.x, event.motion.y);
+                LOG_TRACE("Mouse at x=%d, y=%d\n", event.motion.x, event.motion.y);
                 continue;
             }
-            printf("Event type=%d\n", event.type);
+            LOG_TRACE("Event type=%d\n", event.type);
             if (event.type == SDL_QUIT) {
-                printf("SDL_QUIT received\n");
+                LOG_DEBUG("SDL_QUIT received\n");
                 choice = -1;
             }
             else if (event.type == SDL_MOUSEBUTTONUP && event.button.button == SDL_BUTTON_LEFT) {
                 int x = event.button.x;
                 int y = event.button.y;
-                printf("Clicked at x=%d, y=%d\n", x, y);
+                LOG_DEBUG("Clicked at x=%d, y=%d\n", x, y);
                 if (x >= quizz_click_x && x < quizz_click_x + quizz_click_w &&
                     y >= quizz_click_y && y < quizz_click_y + quizz_click_h) {
-                    printf("Clicked quizz.png\n");
+                    LOG_DEBUG("Clicked quizz.png\n");
                     choice = 1;
                 }
                 else if (x >= puz_click_x && x < puz_click_x + puz_click_w &&
                          y >= puz_click_y && y < puz_click_y + puz_click_h) {
-                    printf("Clicked puz.png\n");
+                    LOG_DEBUG("Clicked puz.png\n");
                     choice = 2;
                 }
                 else {
-                    printf("Clicked outside both areas\n");
+                    LOG_DEBUG("Clicked outside both areas\n");
                 }
-                while (SDL_PollEvent(&event)); // Clear queue
+                while (input_poll_event(&event)); // Clear queue
             }
         }
-        // Redraw screen
-        SDL_FillRect(ecran, NULL, SDL_MapRGB(ecran->format, 0, 0, 0));
-        SDL_BlitSurface(bg, NULL, ecran, &pos_bg);
-        SDL_BlitSurface(quizz, NULL, ecran, &pos_quizz);
-        SDL_BlitSurface(puz, NULL, ecran, &pos_puz);
-        SDL_Flip(ecran);
+        // Nothing on this screen changes: redraw only if the whole screen must be presented
+        if (dirty_full_pending()) {
+            SDL_FillRect(ecran, NULL, SDL_MapRGB(ecran->format, 0, 0, 0));
+            SDL_BlitSurface(bg, NULL, ecran, &pos_bg);
+            SDL_BlitSurface(quizz, NULL, ecran, &pos_quizz);
+            SDL_BlitSurface(puz, NULL, ecran, &pos_puz);
+            dirty_present(ecran);
+        }
         SDL_Delay(10);
     }
 
-    printf("Exiting with choice=%d\n", choice);
+    LOG_DEBUG("Exiting with choice=%d\n", choice);
     SDL_FreeSurface(bg);
     SDL_FreeSurface(quizz);
     SDL_FreeSurface(puz);
@@ -554,16 +568,16 @@ int afficher_ecran_accueil(SDL_Surface *ecran) {
 void afficher_game_over(SDL_Surface *ecran) {
     if (!ecran) return;
 
-    SDL_Surface *game_over = IMG_Load("game_over.png");
+    SDL_Surface *game_over = asset_load_image("game_over.png");
     if (!game_over) {
-        printf("Failed to load game_over.png: %s\n", IMG_GetError());
+        LOG_ERROR("Failed to load game_over.png: %s\n", IMG_GetError());
         return;
     }
     
     SDL_Rect pos = {(SCREEN_WIDTH - game_over->w) / 2, (SCREEN_HEIGHT - game_over->h) / 2};
     SDL_FillRect(ecran, NULL, SDL_MapRGB(ecran->format, 0, 0, 0));
     SDL_BlitSurface(game_over, NULL, ecran, &pos);
-    SDL_Flip(ecran);
+    dirty_flip(ecran);
     SDL_Delay(3000);
     SDL_FreeSurface(game_over);
 }
@@ -571,16 +585,16 @@ void afficher_game_over(SDL_Surface *ecran) {
 void afficher_victoire(SDL_Surface *ecran) {
     if (!ecran) return;
 
-    SDL_Surface *victoire = IMG_Load("victoire.png");
+    SDL_Surface *victoire = asset_load_image("victoire.png");
     if (!victoire) {
-        printf("Failed to load victoire.png: %s\n", IMG_GetError());
+        LOG_ERROR("Failed to load victoire.png: %s\n", IMG_GetError());
         return;
     }
     
     SDL_Rect pos = {(SCREEN_WIDTH - victoire->w) / 2, (SCREEN_HEIGHT - victoire->h) / 2};
     SDL_FillRect(ecran, NULL, SDL_MapRGB(ecran->format, 0, 0, 0));
     SDL_BlitSurface(victoire, NULL, ecran, &pos);
-    SDL_Flip(ecran);
+    dirty_flip(ecran);
     SDL_Delay(3000);
     SDL_FreeSurface(victoire);
 }
@@ -35,9 +35,6 @@ typedef struct {
     SDL_Surface *vies_surface[MAX_VIES];
     SDL_Surface *score_surface;
     SDL_Surface *level_surface;
-    Mix_Chunk *sound;
-    Mix_Chunk *correct_sound;
-    Mix_Chunk *wrong_sound;
     SDL_Rect pos_timer;
     SDL_Rect pos_question;
     SDL_Rect pos_reponse1;
@@ -0,0 +1,64 @@
+/**
+ * @file fonts.c
+ * @brief Shared font registry: every font is opened once and borrowed by the modules.
+ * @author MohamedNourMraad
+ * @date 2025-05-21
+ * @version 1.0
+ */
+
+#include <SDL/SDL.h>
+#include <SDL/SDL_ttf.h>
+#include <stdio.h>
+#include <string.h>
+#include "fonts.h"
+#include "text.h"
+#include "assets.h"
+#include "log.h"
+
+/**
+ * @brief One opened font.
+ */
+typedef struct {
+    char path[64];
+    int ptsize;
+    TTF_Font *font;
+} FontEntry;
+
+static FontEntry fonts[FONT_MAX];
+
+TTF_Font *font_get(const char *path, int ptsize) {
+    int free_slot = -1;
+
+    for (int i = 0; i < FONT_MAX; i++) {
+        if (fonts[i].font == NULL) {
+            if (free_slot < 0) free_slot = i;
+        } else if (fonts[i].ptsize == ptsize && strcmp(fonts[i].path, path) == 0) {
+            return fonts[i].font;
+        }
+    }
+
+    if (free_slot < 0) {
+        LOG_ERROR("Registre de polices plein, impossible d'ouvrir %s (%d)\n", path, ptsize);
+        return NULL;
+    }
+    SDL_RWops *rw = asset_open_rw(path); // Stays open while the font is: archive mapping or file
+    TTF_Font *font = rw ? TTF_OpenFontRW(rw, 1, ptsize) : NULL;
+    if (font == NULL) {
+        LOG_ERROR("Unable to load font %s: %s\n", path, TTF_GetError());
+        return NULL;
+    }
+    snprintf(fonts[free_slot].path, sizeof(fonts[free_slot].path), "%s", path);
+    fonts[free_slot].ptsize = ptsize;
+    fonts[free_slot].font = font;
+    return font;
+}
+
+void fonts_close_all(void) {
+    text_cache_clear(); // Cached text is keyed by font handle
+    for (int i = 0; i < FONT_MAX; i++) {
+        if (fonts[i].font) {
+            TTF_CloseFont(fonts[i].font);
+            fonts[i].font = NULL;
+        }
+    }
+}
@@ -0,0 +1,34 @@
+/**
+ * @file fonts.h
+ * @brief Shared font registry: every font is opened once and borrowed by the modules.
+ * @author MohamedNourMraad
+ * @date 2025-05-21
+ * @version 1.0
+ */
+
+#ifndef FONTS_H
+#define FONTS_H
+
+#include <SDL/SDL.h>
+#include <SDL/SDL_ttf.h>
+
+#define FONT_MAX 8               // Distinct (file, size) pairs the registry can hold
+#define FONT_HUD_FILE "arial.ttf"
+#define FONT_HUD_SIZE 24
+
+/**
+ * @brief Returns the font for a file and size, opening it on first use only.
+ *        The handle is borrowed: never close it, call fonts_close_all at shutdown.
+ * @param path The font file.
+ * @param ptsize The point size.
+ * @return The font, or NULL on failure.
+ */
+TTF_Font *font_get(const char *path, int ptsize);
+
+/**
+ * @brief Clears the text cache and closes every font of the registry.
+ * @return Nothing.
+ */
+void fonts_close_all(void);
+
+#endif // FONTS_H
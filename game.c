@@ -1,4 +1,9 @@
 #include "game.h"
+#include "assets.h"
+#include "dirty.h"
+#include "fonts.h"
+#include "log.h"
+#include "input.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -38,114 +43,237 @@ static void initMaze(Maze* maze) {
     }
 }
 
-// Initialisation du jeu
-void initGame(Game* game, SDL_Surface* screen) {
-    if (TTF_Init() == -1) {
-        fprintf(stderr, "Erreur TTF: %s\n", TTF_GetError());
-        SDL_Quit();
-        exit(1);
-    }
-
+// Chargement des ressources du labyrinthe, une seule fois avec celles du niveau
+int initGame(Game* game, SDL_Surface* screen) {
+    // SDL_ttf est initialisé par main.c ; la police est empruntée au registre
     game->screen = screen;
+    game->font = font_get(FONT_HUD_FILE, FONT_HUD_SIZE);
 
     // Initialisation des ressources
-    game->resources.quitButton = loadImage("quit.png");
-    game->resources.quitButtonHovered = loadImage("quit2.png");
-    game->resources.background = loadImage("background.png");
-    game->resources.map = loadImage("map.png");
-    game->resources.successImage = loadImage("VICTOIRE.png");
-    game->resources.failureImage = loadImage("echec.png");
+    loadImage(&game->resources.quitButton, "quit.png");
+    loadImage(&game->resources.quitButtonHovered, "quit2.png");
+    loadImage(&game->resources.background, "background.png");
+    loadImage(&game->resources.map, "map.png");
+    loadImage(&game->resources.successImage, "VICTOIRE.png");
+    loadImage(&game->resources.failureImage, "echec.png");
 
     // Chargement des images d'horloge
     char filename[32];
     for (int i = 0; i < CLOCK_IMAGES; i++) {
         sprintf(filename, "clock/clock %d.png", i);
-        game->resources.clockImages[i] = loadImage(filename);
+        loadImage(&game->resources.clockImages[i], filename);
         if (!game->resources.clockImages[i]) {
-            fprintf(stderr, "Erreur lors du chargement de %s\n", filename);
+            LOG_ERROR("Erreur lors du chargement de %s\n", filename);
             cleanupGame(game);
-            exit(1);
+            return -1;
         }
     }
 
-    // Initialisation du joueur
-    game->player.x = 1;
-    game->player.y = 1;
-    game->player.image = loadImage("player.png");
+    // Image du joueur (la position est fixée par startGame)
+    loadImage(&game->player.image, "player.png");
 
     // Vérification des chargements
     if (!game->resources.quitButton || !game->resources.quitButtonHovered || 
         !game->resources.background || !game->resources.map || 
         !game->player.image || !game->resources.successImage || 
         !game->resources.failureImage) {
-        fprintf(stderr, "Erreur lors du chargement des ressources\n");
+        LOG_ERROR("Erreur lors du chargement des ressources\n");
         cleanupGame(game);
-        exit(1);
+        return -1;
+    }
+
+    // Zone de l'horloge : les images n'ont pas toutes la même taille
+    game->clockArea.x = 50;
+    game->clockArea.y = 50;
+    game->clockArea.w = 0;
+    game->clockArea.h = 0;
+    for (int i = 0; i < CLOCK_IMAGES; i++) {
+        if (game->resources.clockImages[i]->w > game->clockArea.w) game->clockArea.w = game->resources.clockImages[i]->w;
+        if (game->resources.clockImages[i]->h > game->clockArea.h) game->clockArea.h = game->resources.clockImages[i]->h;
     }
 
-    // Initialisation du labyrinthe
+    // Initialisation du labyrinthe, pré-rendu une fois pour toutes
     initMaze(&game->maze);
+    game->layer = NULL;
+    game->layerDirty = 1;
+    buildMazeLayer(game);
+    game->running = 0;
+    return 0;
+}
 
-    game->startTime = SDL_GetTicks();
+// Début d'une partie : rien n'est chargé ici, entrer dans le labyrinthe ne coûte rien
+void startGame(Game* game) {
+    game->player.x = 1;
+    game->player.y = 1;
+    game->drawnX = -1;
+    game->drawnY = -1;
+    game->drawnClock = -1;
+    dirty_invalidate(); // Le premier affichage couvre tout l'écran
+    game->startTime = input_ticks();
     game->running = 1;
 }
 
 // Nettoyage des ressources
 void cleanupGame(Game* game) {
-    SDL_FreeSurface(game->resources.quitButton);
-    SDL_FreeSurface(game->resources.quitButtonHovered);
-    SDL_FreeSurface(game->resources.background);
-    SDL_FreeSurface(game->resources.map);
-    SDL_FreeSurface(game->player.image);
-    SDL_FreeSurface(game->resources.successImage);
-    SDL_FreeSurface(game->resources.failureImage);
+    asset_free(&game->resources.quitButton);
+    asset_free(&game->resources.quitButtonHovered);
+    asset_free(&game->resources.background);
+    asset_free(&game->resources.map);
+    asset_free(&game->player.image);
+    asset_free(&game->resources.successImage);
+    asset_free(&game->resources.failureImage);
     for (int i = 0; i < CLOCK_IMAGES; i++) {
-        SDL_FreeSurface(game->resources.clockImages[i]);
+        asset_free(&game->resources.clockImages[i]);
+    }
+    memset(&game->resources, 0, sizeof(game->resources));
+    game->player.image = NULL;
+    if (game->layer) {
+        SDL_FreeSurface(game->layer);
+        game->layer = NULL;
     }
-    // Ne pas libérer game->screen ici, car il est géré par main.c
-    TTF_Quit();
+    // Ne pas libérer game->screen ni game->font ici, car ils sont gérés par main.c
+    game->font = NULL;
 }
 
-SDL_Surface* loadImage(const char* file) {
-    SDL_Surface* img = IMG_Load(file);
+SDL_Surface* loadImage(SDL_Surface** slot, const char* file) {
+    SDL_Surface* img = asset_load(slot, file); // Partagée avec le reste du jeu si déjà chargée
     if (!img) {
-        fprintf(stderr, "Erreur de chargement de l'image %s: %s\n", file, IMG_GetError());
+        LOG_ERROR("Erreur de chargement de l'image %s: %s\n", file, IMG_GetError());
     }
     return img;
 }
 
-void drawBackground(Game* game) {
+void drawBackground(Game* game, SDL_Surface* target) {
     SDL_Rect rect = {0, 0, SCREEN_WIDTH, SCREEN_HEIGHT};
-    SDL_BlitSurface(game->resources.background, NULL, game->screen, &rect);
+    SDL_BlitSurface(game->resources.background, NULL, target, &rect);
 }
 
-void drawMap(Game* game) {
+void drawMap(Game* game, SDL_Surface* target) {
     SDL_Rect map_rect;
     map_rect.x = (SCREEN_WIDTH - MAZE_WIDTH * TILE_SIZE) / 2;
     map_rect.y = (SCREEN_HEIGHT - MAZE_HEIGHT * TILE_SIZE) / 2;
-    SDL_BlitSurface(game->resources.map, NULL, game->screen, &map_rect);
+    SDL_BlitSurface(game->resources.map, NULL, target, &map_rect);
 }
 
-void drawMaze(Game* game) {
+void drawMaze(Game* game, SDL_Surface* target) {
     SDL_Rect tile = {0, 0, TILE_SIZE, TILE_SIZE};
     int offsetX = (SCREEN_WIDTH - MAZE_WIDTH * TILE_SIZE) / 2;
     int offsetY = (SCREEN_HEIGHT - MAZE_HEIGHT * TILE_SIZE) / 2;
+    Uint32 wall = SDL_MapRGB(target->format, 126, 160, 159);
+    Uint32 exit_tile = SDL_MapRGB(target->format, 255, 0, 0);
+    Uint32 floor = SDL_MapRGB(target->format, 222, 229, 229);
 
     for (int y = 0; y < MAZE_HEIGHT; y++) {
         for (int x = 0; x < MAZE_WIDTH; x++) {
             tile.x = offsetX + x * TILE_SIZE;
             tile.y = offsetY + y * TILE_SIZE;
+            tile.w = TILE_SIZE; // SDL_FillRect rend le rectangle découpé
+            tile.h = TILE_SIZE;
             if (game->maze.grid[y][x] == 1) {
-                SDL_FillRect(game->screen, &tile, SDL_MapRGB(game->screen->format, 126, 160, 159));
+                SDL_FillRect(target, &tile, wall);
             } else if (game->maze.grid[y][x] == 2) {
-                SDL_FillRect(game->screen, &tile, SDL_MapRGB(game->screen->format, 255, 0, 0));
+                SDL_FillRect(target, &tile, exit_tile);
             } else {
-                SDL_FillRect(game->screen, &tile, SDL_MapRGB(game->screen->format, 222, 229, 229));
+                SDL_FillRect(target, &tile, floor);
             }
         }
     }
 }
 
+// Vrai si la couche a la taille et le format de pixels de l'écran (sinon chaque recopie passe
+// par le blitter de conversion de SDL)
+static int layerMatchesScreen(const SDL_Surface* layer, const SDL_Surface* screen) {
+    return layer != NULL && layer->w == screen->w && layer->h == screen->h &&
+           layer->format->BitsPerPixel == screen->format->BitsPerPixel &&
+           layer->format->Rmask == screen->format->Rmask &&
+           layer->format->Gmask == screen->format->Gmask &&
+           layer->format->Bmask == screen->format->Bmask;
+}
+
+// Pré-rendu du fond, de la carte et du labyrinthe au format de l'écran (à refaire si maze.grid
+// ou le mode vidéo change)
+int buildMazeLayer(Game* game) {
+    SDL_Surface* screen = game->screen;
+    if (!layerMatchesScreen(game->layer, screen)) {
+        if (game->layer) SDL_FreeSurface(game->layer);
+        game->layer = SDL_CreateRGBSurface(SDL_SWSURFACE, screen->w, screen->h, screen->format->BitsPerPixel,
+                                           screen->format->Rmask, screen->format->Gmask, screen->format->Bmask, 0);
+        if (game->layer == NULL) {
+            LOG_ERROR("Impossible de créer la couche du labyrinthe : %s\n", SDL_GetError());
+            return -1;
+        }
+    }
+    SDL_FillRect(game->layer, NULL, SDL_MapRGB(game->layer->format, 0, 0, 0));
+    drawBackground(game, game->layer);
+    drawMap(game, game->layer);
+    drawMaze(game, game->layer);
+    game->layerDirty = 0;
+    LOG_DEBUG("Couche du labyrinthe construite (%dx%d)\n", game->layer->w, game->layer->h);
+    return 0;
+}
+
+// Recopie la couche statique sur une zone de l'écran (efface le joueur ou l'horloge)
+static void restoreLayer(Game* game, const SDL_Rect* area) {
+    SDL_Rect src = *area;
+    SDL_Rect dst = *area; // La couche a la taille et l'origine de l'écran
+    dirty_blit(game->layer, &src, game->screen, &dst);
+}
+
+// Index de l'image d'horloge pour le temps restant
+static int clockIndex(Game* game) {
+    Uint32 elapsed_time = input_ticks() - game->startTime;
+    int time_left = 60000 - elapsed_time; // Temps restant en ms
+    if (time_left < 0) time_left = 0;
+
+    // Calculer l'index de l'image (0 à 10) en fonction du temps restant
+    int index = (time_left * CLOCK_IMAGES) / 60000; // Proportion du temps restant
+    if (index >= CLOCK_IMAGES) index = CLOCK_IMAGES - 1;
+    if (index < 0) index = 0;
+    return index;
+}
+
+// Affichage d'une image du labyrinthe : la couche statique n'est recopiée en entier que si
+// tout l'écran doit être présenté, sinon seules les cases du joueur et l'horloge sont redessinées
+void drawMazeFrame(Game* game) {
+    if ((game->layerDirty || !layerMatchesScreen(game->layer, game->screen)) && buildMazeLayer(game) == 0) {
+        dirty_invalidate();
+    }
+
+    int full = dirty_full_pending() || game->layer == NULL;
+    if (full) {
+        if (game->layer) {
+            SDL_BlitSurface(game->layer, NULL, game->screen, NULL);
+        } else {
+            drawBackground(game, game->screen);
+            drawMap(game, game->screen);
+            drawMaze(game, game->screen);
+            dirty_invalidate();
+        }
+        game->drawnX = -1;
+        game->drawnClock = -1;
+    }
+
+    if (game->player.x != game->drawnX || game->player.y != game->drawnY) {
+        if (game->drawnX >= 0) {
+            int offsetX = (SCREEN_WIDTH - MAZE_WIDTH * TILE_SIZE) / 2;
+            int offsetY = (SCREEN_HEIGHT - MAZE_HEIGHT * TILE_SIZE) / 2;
+            SDL_Rect old = {offsetX + game->drawnX * TILE_SIZE, offsetY + game->drawnY * TILE_SIZE,
+                            game->player.image->w, game->player.image->h};
+            restoreLayer(game, &old);
+        }
+        drawPlayer(game);
+        game->drawnX = game->player.x;
+        game->drawnY = game->player.y;
+    }
+
+    if (clockIndex(game) != game->drawnClock) {
+        if (game->drawnClock >= 0) {
+            restoreLayer(game, &game->clockArea);
+        }
+        drawClock(game);
+    }
+}
+
 void drawPlayer(Game* game) {
     SDL_Rect player_rect;
     player_rect.w = TILE_SIZE;
@@ -154,22 +282,16 @@ void drawPlayer(Game* game) {
     int offsetY = (SCREEN_HEIGHT - MAZE_HEIGHT * TILE_SIZE) / 2;
     player_rect.x = offsetX + game->player.x * TILE_SIZE;
     player_rect.y = offsetY + game->player.y * TILE_SIZE;
-    SDL_BlitSurface(game->player.image, NULL, game->screen, &player_rect);
+    dirty_blit(game->player.image, NULL, game->screen, &player_rect);
 }
 
 void drawClock(Game* game) {
-    Uint32 elapsed_time = SDL_GetTicks() - game->startTime;
-    int time_left = 60000 - elapsed_time; // Temps restant en ms
-    if (time_left < 0) time_left = 0;
-
-    // Calculer l'index de l'image (0 à 10) en fonction du temps restant
-    int index = (time_left * CLOCK_IMAGES) / 60000; // Proportion du temps restant
-    if (index >= CLOCK_IMAGES) index = CLOCK_IMAGES - 1;
-    if (index < 0) index = 0;
+    int index = clockIndex(game);
 
     // Position de l'horloge
-    SDL_Rect clock_rect = {50, 50, 0, 0};
-    SDL_BlitSurface(game->resources.clockImages[index], NULL, game->screen, &clock_rect);
+    SDL_Rect clock_rect = {game->clockArea.x, game->clockArea.y, 0, 0};
+    dirty_blit(game->resources.clockImages[index], NULL, game->screen, &clock_rect);
+    game->drawnClock = index;
 }
 
 int isMoveValid(Game* game, int new_x, int new_y) {
@@ -184,14 +306,18 @@ void drawResult(Game* game, SDL_Surface* result_img) {
     quit_pos.x = result_rect.x + (result_img->w - game->resources.quitButton->w) / 2;
     quit_pos.y = result_rect.y + result_img->h - 120;
 
-    SDL_BlitSurface(result_img, NULL, game->screen, &result_rect);
-    SDL_BlitSurface(game->resources.quitButton, NULL, game->screen, &quit_pos);
-    SDL_Flip(game->screen);
+    SDL_Rect pos = result_rect;
+    SDL_BlitSurface(result_img, NULL, game->screen, &pos);
+    pos = quit_pos;
+    SDL_BlitSurface(game->resources.quitButton, NULL, game->screen, &pos);
+    dirty_invalidate(); // Dessiné par-dessus le labyrinthe : la première présentation est complète
+    dirty_present(game->screen);
 
     SDL_Event event;
     int waiting = 1;
+    int hovered = 0;
     while (waiting) {
-        while (SDL_PollEvent(&event)) {
+        while (input_poll_event(&event)) {
             switch (event.type) {
                 case SDL_QUIT:
                     waiting = 0;
@@ -200,18 +326,30 @@ void drawResult(Game* game, SDL_Surface* result_img) {
                     if (event.key.keysym.sym == SDLK_RETURN || event.key.keysym.sym == SDLK_ESCAPE)
                         waiting = 0;
                     break;
-                case SDL_MOUSEMOTION:
-                    if (event.motion.x >= quit_pos.x && event.motion.x <= quit_pos.x + game->resources.quitButton->w &&
-                        event.motion.y >= quit_pos.y && event.motion.y <= quit_pos.y + game->resources.quitButton->h) {
-                        SDL_BlitSurface(result_img, NULL, game->screen, &result_rect);
-                        SDL_BlitSurface(game->resources.quitButtonHovered, NULL, game->screen, &quit_pos);
-                        SDL_Flip(game->screen);
+                case SDL_MOUSEMOTION: {
+                    int over = event.motion.x >= quit_pos.x && event.motion.x <= quit_pos.x + game->resources.quitButton->w &&
+                               event.motion.y >= quit_pos.y && event.motion.y <= quit_pos.y + game->resources.quitButton->h;
+                    if (over == hovered && !dirty_full_pending()) {
+                        break; // Même image de bouton : rien à redessiner
+                    }
+                    hovered = over;
+                    SDL_Surface *button = over ? game->resources.quitButtonHovered : game->resources.quitButton;
+                    if (dirty_full_pending()) {
+                        pos = result_rect;
+                        dirty_blit(result_img, NULL, game->screen, &pos);
                     } else {
-                        SDL_BlitSurface(result_img, NULL, game->screen, &result_rect);
-                        SDL_BlitSurface(game->resources.quitButton, NULL, game->screen, &quit_pos);
-                        SDL_Flip(game->screen);
+                        // Ne redessiner l'image du résultat que sous le bouton
+                        SDL_Rect area = {quit_pos.x - result_rect.x, quit_pos.y - result_rect.y,
+                                         game->resources.quitButton->w > game->resources.quitButtonHovered->w ? game->resources.quitButton->w : game->resources.quitButtonHovered->w,
+                                         game->resources.quitButton->h > game->resources.quitButtonHovered->h ? game->resources.quitButton->h : game->resources.quitButtonHovered->h};
+                        pos = quit_pos;
+                        dirty_blit(result_img, &area, game->screen, &pos);
                     }
+                    pos = quit_pos;
+                    dirty_blit(button, NULL, game->screen, &pos);
+                    dirty_present(game->screen);
                     break;
+                }
                 case SDL_MOUSEBUTTONDOWN:
                     if (event.button.button == SDL_BUTTON_LEFT &&
                         event.button.x >= quit_pos.x && event.button.x <= quit_pos.x + game->resources.quitButton->w &&
@@ -35,19 +35,28 @@ typedef struct {
 
 typedef struct {
     SDL_Surface* screen;
+    TTF_Font* font; // Emprunté au registre de polices, ne pas fermer
     Player player;
     Maze maze;
     Resources resources;
     Uint32 startTime;
     int running;
+    SDL_Surface* layer;    // Fond, carte et labyrinthe pré-rendus (taille de l'écran)
+    int layerDirty;        // maze.grid a changé depuis la construction de layer
+    SDL_Rect clockArea;    // Zone couverte par la plus grande image d'horloge
+    int drawnX, drawnY;    // Case du joueur affichée à l'écran (-1 : aucune)
+    int drawnClock;        // Image d'horloge affichée à l'écran (-1 : aucune)
 } Game;
 
-void initGame(Game* game, SDL_Surface* screen);
+int initGame(Game* game, SDL_Surface* screen);
+void startGame(Game* game);
 void cleanupGame(Game* game);
-SDL_Surface* loadImage(const char* file);
-void drawBackground(Game* game);
-void drawMap(Game* game);
-void drawMaze(Game* game);
+SDL_Surface* loadImage(SDL_Surface** slot, const char* file);
+void drawBackground(Game* game, SDL_Surface* target);
+void drawMap(Game* game, SDL_Surface* target);
+void drawMaze(Game* game, SDL_Surface* target);
+int buildMazeLayer(Game* game);
+void drawMazeFrame(Game* game);
 void drawPlayer(Game* game);
 void drawClock(Game* game);
 int isMoveValid(Game* game, int new_x, int new_y);
@@ -0,0 +1,374 @@
+/**
+ * @file input.c
+ * @brief Game clock and input source. Gameplay reads the time, the events and the
+ *        keyboard state through here instead of SDL, so a session can be recorded to a
+ *        compact binary trace and replayed bit-exactly (same ticks, same events, same
+ *        random seed), e.g. to compare performance work on identical runs.
+ *        Main thread only.
+ * @author MohamedNourMraad
+ * @date 2025-06-04
+ * @version 1.0
+ */
+
+#include <SDL/SDL.h>
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "input.h"
+#include "log.h"
+
+/*
+ * Trace layout: INPUT_MAGIC, INPUT_VERSION (1 byte), the seed (4 bytes, little endian),
+ * then one record per answer, in the order the game asked. Each record starts with a byte:
+ *   0x00-0x7E  input_ticks: time elapsed since the previous answer
+ *   0x7F       input_ticks: same, as a varint (7 bits per byte, low bits first)
+ *   0x80       input_poll_event: no event
+ *   0x81       input_poll_event: type (1 byte), then its fields as varints
+ *   0x82       input_key_state: no key changed since the previous answer
+ *   0x83       input_key_state: count, then count x (key varint, state byte)
+ *   0x84/0x85  input_flag: 0/1
+ */
+enum {
+    REC_TICKS_LONG = 0x7F,
+    REC_NO_EVENT = 0x80,
+    REC_EVENT,
+    REC_KEYS_SAME,
+    REC_KEYS,
+    REC_FLAG_0,
+    REC_FLAG_1
+};
+
+static InputMode mode = INPUT_LIVE;
+static FILE *trace = NULL;
+static unsigned int seed = 0;
+static Uint32 last_ticks = 0;     // Last time handed out
+static Uint32 clock_offset = 0;   // Added to SDL_GetTicks once a replay hands over to live input
+static Uint8 keys[SDLK_LAST];     // Keyboard state as last written (record) or read (replay)
+static Uint32 records = 0;
+
+/**
+ * @brief Writes a varint to the trace.
+ * @param v The value.
+ * @return Nothing.
+ */
+static void put_varint(Uint32 v) {
+    while (v >= 0x80) {
+        fputc((v & 0x7F) | 0x80, trace);
+        v >>= 7;
+    }
+    fputc(v, trace);
+}
+
+/**
+ * @brief Reads a varint from the trace.
+ * @param v Receives the value.
+ * @return 0 on success, -1 if the trace ends or the value is malformed.
+ */
+static int get_varint(Uint32 *v) {
+    *v = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+        int c = fgetc(trace);
+        if (c == EOF) {
+            return -1;
+        }
+        *v |= (Uint32)(c & 0x7F) << shift;
+        if (!(c & 0x80)) {
+            return 0;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Ends a replay: closes the trace and lets live input take over. The clock
+ *        carries on from the last replayed time.
+ * @param ended 1 if the trace was read to its end, 0 if it no longer matches the game.
+ * @return Nothing.
+ */
+static void stop_replay(int ended) {
+    if (ended) {
+        LOG_INFO("Fin du rejeu après %u enregistrements, entrées en direct\n", records);
+    } else {
+        LOG_ERROR("Rejeu désynchronisé à l'enregistrement %u (trace d'une autre version ?), entrées en direct\n", records);
+    }
+    clock_offset = last_ticks - SDL_GetTicks();
+    fclose(trace);
+    trace = NULL;
+    mode = INPUT_LIVE;
+}
+
+/**
+ * @brief Reads the header byte of the next replayed record.
+ * @param first Lowest header the caller accepts.
+ * @param last Highest header the caller accepts.
+ * @return The header, or -1 if the replay stopped (end of trace or mismatch).
+ */
+static int next_record(int first, int last) {
+    int c = fgetc(trace);
+    if (c == EOF) {
+        stop_replay(1);
+        return -1;
+    }
+    if (c < first || c > last) {
+        stop_replay(0);
+        return -1;
+    }
+    records++;
+    return c;
+}
+
+/**
+ * @brief Appends an event to the trace (only the fields the game reads).
+ * @param e The event.
+ * @return Nothing.
+ */
+static void write_event(const SDL_Event *e) {
+    fputc(REC_EVENT, trace);
+    fputc(e->type, trace);
+    switch (e->type) {
+        case SDL_KEYDOWN:
+        case SDL_KEYUP:
+            put_varint(e->key.keysym.sym);
+            put_varint(e->key.keysym.mod);
+            break;
+        case SDL_MOUSEMOTION:
+            put_varint(e->motion.x);
+            put_varint(e->motion.y);
+            break;
+        case SDL_MOUSEBUTTONDOWN:
+        case SDL_MOUSEBUTTONUP:
+            fputc(e->button.button, trace);
+            put_varint(e->button.x);
+            put_varint(e->button.y);
+            break;
+        default:
+            break; // SDL_QUIT has no fields
+    }
+}
+
+/**
+ * @brief Reads the event of a REC_EVENT record.
+ * @param e Receives the event.
+ * @return 0 on success, -1 if the record is truncated or unknown.
+ */
+static int read_event(SDL_Event *e) {
+    Uint32 a, b;
+    int type = fgetc(trace);
+
+    memset(e, 0, sizeof(*e));
+    e->type = type;
+    switch (type) {
+        case SDL_KEYDOWN:
+        case SDL_KEYUP:
+            if (get_varint(&a) < 0 || get_varint(&b) < 0) return -1;
+            e->key.state = type == SDL_KEYDOWN ? SDL_PRESSED : SDL_RELEASED;
+            e->key.keysym.sym = (SDLKey)a;
+            e->key.keysym.mod = (SDLMod)b;
+            return 0;
+        case SDL_MOUSEMOTION:
+            if (get_varint(&a) < 0 || get_varint(&b) < 0) return -1;
+            e->motion.x = a;
+            e->motion.y = b;
+            return 0;
+        case SDL_MOUSEBUTTONDOWN:
+        case SDL_MOUSEBUTTONUP: {
+            int button = fgetc(trace);
+            if (button == EOF || get_varint(&a) < 0 || get_varint(&b) < 0) return -1;
+            e->button.button = button;
+            e->button.state = type == SDL_MOUSEBUTTONDOWN ? SDL_PRESSED : SDL_RELEASED;
+            e->button.x = a;
+            e->button.y = b;
+            return 0;
+        }
+        case SDL_QUIT:
+            return 0;
+        default:
+            return -1;
+    }
+}
+
+int input_open(InputMode m, const char *path) {
+    seed = (unsigned int)time(NULL);
+    memset(keys, 0, sizeof(keys));
+    last_ticks = 0;
+    clock_offset = 0;
+    if (m == INPUT_LIVE) {
+        return 0;
+    }
+
+    trace = fopen(path, m == INPUT_RECORD ? "wb" : "rb");
+    if (trace == NULL) {
+        LOG_ERROR("Impossible d'ouvrir la trace %s : %s\n", path, strerror(errno));
+        return -1;
+    }
+    Uint8 header[9];
+    if (m == INPUT_RECORD) {
+        memcpy(header, INPUT_MAGIC, 4);
+        header[4] = INPUT_VERSION;
+        for (int i = 0; i < 4; i++) header[5 + i] = (Uint8)(seed >> (8 * i));
+        fwrite(header, 1, sizeof(header), trace);
+    } else {
+        if (fread(header, 1, sizeof(header), trace) != sizeof(header) ||
+            memcmp(header, INPUT_MAGIC, 4) != 0 || header[4] != INPUT_VERSION) {
+            LOG_ERROR("%s n'est pas une trace de version %d\n", path, INPUT_VERSION);
+            fclose(trace);
+            trace = NULL;
+            return -1;
+        }
+        seed = 0;
+        for (int i = 0; i < 4; i++) seed |= (unsigned int)header[5 + i] << (8 * i);
+    }
+    mode = m;
+    records = 0;
+    LOG_INFO("%s des entrées : %s\n", m == INPUT_RECORD ? "Enregistrement" : "Rejeu", path);
+    return 0;
+}
+
+Uint32 input_ticks(void) {
+    if (mode == INPUT_REPLAY) {
+        int c = next_record(0x00, REC_TICKS_LONG);
+        if (c >= 0) {
+            Uint32 delta = c;
+            if (c == REC_TICKS_LONG && get_varint(&delta) < 0) {
+                stop_replay(0);
+            } else {
+                last_ticks += delta;
+                return last_ticks;
+            }
+        }
+    }
+
+    Uint32 now = SDL_GetTicks() + clock_offset;
+    if (mode == INPUT_RECORD) {
+        Uint32 delta = now - last_ticks;
+        if (delta < REC_TICKS_LONG) {
+            fputc(delta, trace); // Almost every read: a frame or less since the previous one
+        } else {
+            fputc(REC_TICKS_LONG, trace);
+            put_varint(delta);
+        }
+        records++;
+    }
+    last_ticks = now;
+    return now;
+}
+
+int input_poll_event(SDL_Event *event) {
+    if (mode == INPUT_REPLAY) {
+        SDL_Event ignored;
+        while (SDL_PollEvent(&ignored)) {
+            // Keeps the window serviced; the trace drives the game
+        }
+        int c = next_record(REC_NO_EVENT, REC_EVENT);
+        if (c == REC_NO_EVENT) {
+            return 0;
+        }
+        if (c == REC_EVENT) {
+            if (read_event(event) == 0) {
+                return 1;
+            }
+            stop_replay(0);
+        }
+    }
+
+    while (SDL_PollEvent(event)) {
+        switch (event->type) {
+            case SDL_QUIT:
+            case SDL_KEYDOWN:
+            case SDL_KEYUP:
+            case SDL_MOUSEMOTION:
+            case SDL_MOUSEBUTTONDOWN:
+            case SDL_MOUSEBUTTONUP:
+                if (mode == INPUT_RECORD) {
+                    write_event(event);
+                    records++;
+                }
+                return 1;
+            default:
+                break; // Focus, expose... never read by the game, not worth a record
+        }
+    }
+    if (mode == INPUT_RECORD) {
+        fputc(REC_NO_EVENT, trace);
+        records++;
+    }
+    return 0;
+}
+
+Uint8 *input_key_state(void) {
+    if (mode == INPUT_REPLAY) {
+        int c = next_record(REC_KEYS_SAME, REC_KEYS);
+        if (c == REC_KEYS_SAME) {
+            return keys;
+        }
+        if (c == REC_KEYS) {
+            Uint32 count, key;
+            int ok = get_varint(&count) == 0;
+            for (Uint32 i = 0; ok && i < count; i++) {
+                int state;
+                ok = get_varint(&key) == 0 && key < SDLK_LAST && (state = fgetc(trace)) != EOF;
+                if (ok) keys[key] = state;
+            }
+            if (ok) {
+                return keys;
+            }
+            stop_replay(0);
+        }
+    }
+
+    int count = 0;
+    Uint8 *live = SDL_GetKeyState(&count);
+    if (mode == INPUT_RECORD) {
+        if (count > SDLK_LAST) count = SDLK_LAST;
+        Uint32 changed = 0;
+        for (int k = 0; k < count; k++) {
+            if (live[k] != keys[k]) changed++;
+        }
+        if (changed == 0) {
+            fputc(REC_KEYS_SAME, trace); // Keys are held for many steps: most reads cost one byte
+        } else {
+            fputc(REC_KEYS, trace);
+            put_varint(changed);
+            for (int k = 0; k < count; k++) {
+                if (live[k] != keys[k]) {
+                    put_varint(k);
+                    fputc(live[k], trace);
+                    keys[k] = live[k];
+                }
+            }
+        }
+        records++;
+    }
+    return live;
+}
+
+int input_flag(int live) {
+    if (mode == INPUT_REPLAY) {
+        int c = next_record(REC_FLAG_0, REC_FLAG_1);
+        if (c >= 0) {
+            return c == REC_FLAG_1;
+        }
+    }
+    if (mode == INPUT_RECORD) {
+        fputc(live ? REC_FLAG_1 : REC_FLAG_0, trace);
+        records++;
+    }
+    return live;
+}
+
+unsigned int input_seed(void) {
+    return seed;
+}
+
+void input_close(void) {
+    if (trace == NULL) {
+        return;
+    }
+    if (mode == INPUT_RECORD) {
+        LOG_INFO("Trace enregistrée : %u enregistrements, %ld octets\n", records, ftell(trace));
+    }
+    fclose(trace);
+    trace = NULL;
+    mode = INPUT_LIVE;
+}
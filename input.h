@@ -0,0 +1,80 @@
+/**
+ * @file input.h
+ * @brief Game clock and input source. Gameplay reads the time, the events and the
+ *        keyboard state through here instead of SDL, so a session can be recorded to a
+ *        compact binary trace and replayed bit-exactly (same ticks, same events, same
+ *        random seed), e.g. to compare performance work on identical runs.
+ *        Main thread only.
+ * @author MohamedNourMraad
+ * @date 2025-06-04
+ * @version 1.0
+ */
+
+#ifndef INPUT_H
+#define INPUT_H
+
+#include <SDL/SDL.h>
+
+#define INPUT_MAGIC "SRRP"  // First bytes of a trace file
+#define INPUT_VERSION 1     // Bumped whenever the record layout changes
+
+/**
+ * @brief Where the time and the input come from.
+ */
+typedef enum {
+    INPUT_LIVE,    // SDL, nothing written
+    INPUT_RECORD,  // SDL, every answer appended to the trace
+    INPUT_REPLAY   // The trace; live input is ignored until it ends
+} InputMode;
+
+/**
+ * @brief Picks the source and opens the trace. Call right after SDL_Init.
+ *        Without a usable trace the game runs live.
+ * @param mode The source.
+ * @param path The trace file (ignored for INPUT_LIVE).
+ * @return 0 on success, -1 if the trace cannot be opened or is not a trace.
+ */
+int input_open(InputMode mode, const char *path);
+
+/**
+ * @brief Game time, to use instead of SDL_GetTicks wherever it changes what happens.
+ *        It never goes back, even when a replay ends and live input takes over.
+ * @return The time in ms.
+ */
+Uint32 input_ticks(void);
+
+/**
+ * @brief Next event, to use instead of SDL_PollEvent. Only quit, key and mouse
+ *        events are returned; the game ignores the others.
+ * @param event Receives the event.
+ * @return 1 if an event was returned, 0 if the queue is empty.
+ */
+int input_poll_event(SDL_Event *event);
+
+/**
+ * @brief Keyboard state, to use instead of SDL_GetKeyState(NULL).
+ * @return An array indexed by SDLKey (valid until the next call).
+ */
+Uint8 *input_key_state(void);
+
+/**
+ * @brief Records any other outside fact the game branches on (e.g. whether the
+ *        intro music is still playing), so the replay takes the same branch.
+ * @param live The live value.
+ * @return The live value, or the recorded one during a replay.
+ */
+int input_flag(int live);
+
+/**
+ * @brief Seed for srand: the time of the session, or the one of the recorded session.
+ * @return The seed.
+ */
+unsigned int input_seed(void);
+
+/**
+ * @brief Flushes and closes the trace, and goes back to live input.
+ * @return Nothing.
+ */
+void input_close(void);
+
+#endif // INPUT_H
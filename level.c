@@ -0,0 +1,50 @@
+/**
+ * @file level.c
+ * @brief Per-level asset streaming: only the level being played is resident, and the
+ *        images of the next one are decoded in the background while it is played.
+ * @author MohamedNourMraad
+ * @date 2025-06-01
+ * @version 1.0
+ */
+
+#include <SDL/SDL.h>
+#include <stdio.h>
+#include "level.h"
+#include "loader.h"
+#include "assets.h"
+#include "log.h"
+
+// Enemy sprite sheet loader of each level
+static int (*const enemy_loaders[LEVEL_COUNT])(Ennemi *) = {loadEnnemiImages, loadEnnemi2Images};
+
+int level_prefetch(int level) {
+    char manifest[32];
+    snprintf(manifest, sizeof(manifest), LEVEL_MANIFEST, level);
+    return loader_start(manifest);
+}
+
+int level_load(int level, Background *bg, Ennemi *enemy, PropStore *props) {
+    Uint32 t0 = SDL_GetTicks();
+
+    if (background_load_level(bg, level) < 0) {
+        return -1;
+    }
+    if (enemy_loaders[level - 1](enemy) < 0) {
+        background_free_level(bg, level);
+        return -1;
+    }
+    if (props_load_level(props, level) < 0) {
+        asset_free(&enemy->image);
+        background_free_level(bg, level);
+        return -1;
+    }
+    LOG_INFO("Niveau %d chargé en %u ms\n", level, SDL_GetTicks() - t0);
+    return 0;
+}
+
+void level_release(int level, Background *bg, Ennemi *enemy, PropStore *props) {
+    background_free_level(bg, level);
+    asset_free(&enemy->image);
+    props_free_level(props, level);
+    LOG_INFO("Niveau %d libéré\n", level);
+}
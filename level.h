@@ -0,0 +1,49 @@
+/**
+ * @file level.h
+ * @brief Per-level asset streaming: only the level being played is resident, and the
+ *        images of the next one are decoded in the background while it is played.
+ * @author MohamedNourMraad
+ * @date 2025-06-01
+ * @version 1.0
+ */
+
+#ifndef LEVEL_H
+#define LEVEL_H
+
+#include <SDL/SDL_ttf.h>
+#include "background.h"
+#include "ennemie.h"
+#include "props.h"
+
+#define LEVEL_COUNT 2
+#define LEVEL_MANIFEST "level%d.txt"  // Images of a level, for the background loader (level 1: preload.txt)
+
+/**
+ * @brief Starts decoding the images of a level on the loader threads.
+ * @param level The level to prefetch (2 .. LEVEL_COUNT).
+ * @return 0 on success, -1 if nothing is prefetched (the level then decodes when entered).
+ */
+int level_prefetch(int level);
+
+/**
+ * @brief Makes a level resident: background, collision map, doors, enemy and prop images.
+ *        Images prefetched by level_prefetch only need their screen conversion.
+ * @param level The level (1 .. LEVEL_COUNT).
+ * @param bg Pointer to the background structure.
+ * @param enemy The enemy of that level.
+ * @param props The prop store.
+ * @return 0 on success, -1 on failure.
+ */
+int level_load(int level, Background *bg, Ennemi *enemy, PropStore *props);
+
+/**
+ * @brief Releases what only a level uses, once it can no longer be played.
+ * @param level The level (1 .. LEVEL_COUNT).
+ * @param bg Pointer to the background structure.
+ * @param enemy The enemy of that level.
+ * @param props The prop store.
+ * @return Nothing.
+ */
+void level_release(int level, Background *bg, Ennemi *enemy, PropStore *props);
+
+#endif // LEVEL_H
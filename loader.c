@@ -0,0 +1,249 @@
+/**
+ * @file loader.c
+ * @brief Background image decoding: a pool of worker threads decodes the images of a
+ *        manifest while the menu and intro are on screen (or the previous level is played);
+ *        the main thread picks the results up through the asset loader and only converts
+ *        them to the screen format.
+ * @author MohamedNourMraad
+ * @date 2025-05-31
+ * @version 1.0
+ */
+
+#include <SDL/SDL.h>
+#include <SDL/SDL_thread.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "loader.h"
+#include "assets.h"
+#include "pak.h"
+#include "log.h"
+
+/**
+ * @brief Where a manifest entry is.
+ */
+typedef enum {
+    JOB_QUEUED,    // Waiting for a worker
+    JOB_DECODING,  // A worker owns it
+    JOB_DONE,      // Decoded (or failed: surface NULL), waiting for the main thread
+    JOB_TAKEN      // Handed over, or withdrawn for the main thread to decode
+} JobState;
+
+/**
+ * @brief One image of the manifest.
+ */
+typedef struct {
+    char name[LOADER_NAME_MAX];
+    JobState state;
+    SDL_Surface *surface;
+    int kind;
+} LoaderJob;
+
+static LoaderJob jobs[LOADER_JOB_MAX];
+static int job_count = 0;
+static int next_job = 0;             // No job before this one is still queued
+static int stop_requested = 0;
+static SDL_mutex *jobs_lock = NULL;
+static SDL_cond *job_done = NULL;
+static SDL_Thread *workers[LOADER_THREADS];
+static int worker_count = 0;
+
+// Statistics, under jobs_lock
+static int decoded = 0;              // Images the workers decoded
+static int handed_over = 0;          // Decoded images the main thread took
+static Uint32 decode_ms = 0;         // Decoding time summed over the workers
+static Uint32 wait_ms = 0;           // Time the main thread waited for a worker
+static Uint32 start_ms = 0;
+static int first_frame_reported = 0;
+
+/**
+ * @brief Worker thread: decodes queued jobs until none is left or loader_finish stops it.
+ * @param data Unused.
+ * @return 0.
+ */
+static int worker_thread(void *data) {
+    (void)data;
+
+    SDL_LockMutex(jobs_lock);
+    for (;;) {
+        while (next_job < job_count && jobs[next_job].state != JOB_QUEUED) {
+            next_job++;
+        }
+        if (stop_requested || next_job == job_count) {
+            break;
+        }
+        LoaderJob *job = &jobs[next_job++];
+        job->state = JOB_DECODING;
+        SDL_UnlockMutex(jobs_lock);
+
+        Uint32 t0 = SDL_GetTicks();
+        int kind = ASSET_OPAQUE;
+        SDL_Surface *surface = asset_decode(job->name, &kind);
+        Uint32 spent = SDL_GetTicks() - t0;
+
+        SDL_LockMutex(jobs_lock);
+        job->surface = surface;
+        job->kind = kind;
+        job->state = JOB_DONE;
+        decode_ms += spent;
+        if (surface) decoded++;
+        SDL_CondBroadcast(job_done); // The main thread may be waiting for this one
+    }
+    SDL_UnlockMutex(jobs_lock);
+    return 0;
+}
+
+/**
+ * @brief Queues one manifest entry, unless it is already queued.
+ * @param name The file name.
+ * @return Nothing.
+ */
+static void queue_job(const char *name) {
+    for (int i = 0; i < job_count; i++) {
+        if (strcmp(jobs[i].name, name) == 0) {
+            return;
+        }
+    }
+    if (job_count == LOADER_JOB_MAX) {
+        LOG_WARN("Trop d'images à précharger (max %d), %s chargée au besoin\n", LOADER_JOB_MAX, name);
+        return;
+    }
+    LoaderJob *job = &jobs[job_count++];
+    snprintf(job->name, sizeof(job->name), "%s", name);
+    job->state = JOB_QUEUED;
+    job->surface = NULL;
+    job->kind = ASSET_OPAQUE;
+}
+
+/**
+ * @brief Reads the manifest into the job table.
+ * @param path The manifest file.
+ * @return 0 on success, -1 if the file cannot be read.
+ */
+static int read_manifest(const char *path) {
+    FILE *fp = fopen(path, "r");
+    if (fp == NULL) {
+        LOG_WARN("Pas de liste de préchargement %s : %s\n", path, strerror(errno));
+        return -1;
+    }
+
+    char line[LOADER_NAME_MAX + 2];
+    while (fgets(line, sizeof(line), fp)) {
+        char *start = line;
+        while (*start == ' ' || *start == '\t') start++;
+        char *end = start + strcspn(start, "\r\n");
+        while (end > start && (end[-1] == ' ' || end[-1] == '\t')) end--;
+        *end = '\0';
+        if (*start == '#' || *start == '\0') continue; // File names may contain spaces
+
+        if (pak_find(start) == NULL) {
+            queue_job(start); // Packed images were decoded by the packer, only a copy is left to do
+        }
+    }
+    fclose(fp);
+    return 0;
+}
+
+int loader_start(const char *path) {
+    loader_finish(); // One manifest at a time
+    decoded = 0;
+    handed_over = 0;
+    decode_ms = 0;
+    wait_ms = 0;
+    start_ms = SDL_GetTicks();
+    if (read_manifest(path) < 0 || job_count == 0) {
+        return -1;
+    }
+    jobs_lock = SDL_CreateMutex();
+    job_done = SDL_CreateCond();
+    if (jobs_lock == NULL || job_done == NULL) {
+        LOG_ERROR("Impossible de créer le chargeur : %s\n", SDL_GetError());
+        loader_finish();
+        return -1;
+    }
+    stop_requested = 0;
+    for (int i = 0; i < LOADER_THREADS; i++) {
+        workers[worker_count] = SDL_CreateThread(worker_thread, NULL);
+        if (workers[worker_count] == NULL) {
+            LOG_WARN("Thread de chargement %d non démarré : %s\n", i, SDL_GetError());
+            continue; // Fewer workers; whatever stays queued loads on the main thread
+        }
+        worker_count++;
+    }
+    LOG_INFO("Préchargement de %d images de %s sur %d threads\n", job_count, path, worker_count);
+    return 0;
+}
+
+SDL_Surface *loader_take(const char *name, int *kind) {
+    if (jobs_lock == NULL) {
+        return NULL;
+    }
+    SDL_Surface *surface = NULL;
+    SDL_LockMutex(jobs_lock);
+    for (int i = 0; i < job_count; i++) {
+        LoaderJob *job = &jobs[i];
+        if (strcmp(job->name, name) != 0) {
+            continue;
+        }
+        if (job->state == JOB_DECODING) {
+            Uint32 t0 = SDL_GetTicks();
+            while (job->state == JOB_DECODING) {
+                SDL_CondWait(job_done, jobs_lock);
+            }
+            wait_ms += SDL_GetTicks() - t0;
+        }
+        if (job->state == JOB_DONE) {
+            surface = job->surface;
+            *kind = job->kind;
+            job->surface = NULL;
+            if (surface) handed_over++;
+        }
+        job->state = JOB_TAKEN; // A queued job is withdrawn: the caller decodes it right away
+        break;
+    }
+    SDL_UnlockMutex(jobs_lock);
+    return surface;
+}
+
+void loader_first_frame(void) {
+    if (first_frame_reported) {
+        return;
+    }
+    first_frame_reported = 1;
+    LOG_INFO("Premier écran interactif à %u ms\n", SDL_GetTicks());
+}
+
+void loader_finish(void) {
+    if (jobs_lock) {
+        SDL_LockMutex(jobs_lock);
+        stop_requested = 1;
+        SDL_UnlockMutex(jobs_lock);
+    }
+    for (int i = 0; i < worker_count; i++) {
+        SDL_WaitThread(workers[i], NULL); // A worker finishes the image it is on
+    }
+    if (worker_count > 0) {
+        LOG_INFO("Préchargement : %d images décodées en %u ms (cumul sur %d threads), "
+                 "%d utilisées, attente %u ms, %u ms depuis le début\n",
+                 decoded, decode_ms, worker_count, handed_over, wait_ms, SDL_GetTicks() - start_ms);
+    }
+    worker_count = 0;
+
+    for (int i = 0; i < job_count; i++) {
+        if (jobs[i].surface) {
+            SDL_FreeSurface(jobs[i].surface); // Preloaded but never asked for (e.g. the other skin)
+            jobs[i].surface = NULL;
+        }
+    }
+    job_count = 0;
+    next_job = 0;
+    if (job_done) {
+        SDL_DestroyCond(job_done);
+        job_done = NULL;
+    }
+    if (jobs_lock) {
+        SDL_DestroyMutex(jobs_lock);
+        jobs_lock = NULL;
+    }
+}
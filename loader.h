@@ -0,0 +1,56 @@
+/**
+ * @file loader.h
+ * @brief Background image decoding: a pool of worker threads decodes the images of a
+ *        manifest while the menu and intro are on screen (or the previous level is played);
+ *        the main thread picks the results up through the asset loader and only converts
+ *        them to the screen format.
+ * @author MohamedNourMraad
+ * @date 2025-05-31
+ * @version 1.0
+ */
+
+#ifndef LOADER_H
+#define LOADER_H
+
+#include <SDL/SDL.h>
+
+#define LOADER_FILE "preload.txt"  // Images decoded while the menu is showing
+#define LOADER_THREADS 3           // Decoding threads (the main thread keeps a core)
+#define LOADER_JOB_MAX 192         // Manifest entries kept, the rest load on the main thread
+#define LOADER_NAME_MAX 64         // Longest file name
+
+/**
+ * @brief Reads the manifest and starts the worker threads, after finishing the previous
+ *        manifest if any. Images found in the open archive are skipped, so call it after
+ *        asset_open_archive.
+ *        Each non-comment line of the manifest is one image file name (spaces allowed).
+ * @param path The manifest file.
+ * @return 0 on success, -1 if nothing could be queued (every image then loads on the main thread).
+ */
+int loader_start(const char *path);
+
+/**
+ * @brief Hands a decoded image over to the caller. Waits if a worker is decoding it;
+ *        an image no worker has started yet is withdrawn so the caller decodes it itself.
+ * @param name The file name.
+ * @param kind Receives the classification (ASSET_OPAQUE, ASSET_COLORKEY or ASSET_ALPHA).
+ * @return The decoded surface, not converted (owned by the caller), or NULL if the
+ *         caller has to read the image itself.
+ */
+SDL_Surface *loader_take(const char *name, int *kind);
+
+/**
+ * @brief Reports the time from SDL_Init to the first frame the player can interact with.
+ *        Only the first call logs.
+ * @return Nothing.
+ */
+void loader_first_frame(void);
+
+/**
+ * @brief Stops the workers, frees the images nobody took and logs the loading statistics.
+ *        Safe to call twice; must run before asset_close_archive.
+ * @return Nothing.
+ */
+void loader_finish(void);
+
+#endif // LOADER_H
@@ -0,0 +1,169 @@
+/**
+ * @file log.c
+ * @brief Leveled logging macros with a compile-time threshold and an optional asynchronous sink.
+ * @author MohamedNourMraad
+ * @date 2025-05-23
+ * @version 1.0
+ */
+
+#include <SDL/SDL.h>
+#include <SDL/SDL_thread.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "log.h"
+
+/**
+ * @brief One formatted line waiting in the ring.
+ */
+typedef struct {
+    int level;
+    char text[LOG_LINE_MAX];
+} LogLine;
+
+static LogLine ring[LOG_RING_SIZE];
+static unsigned int ring_head = 0;   // Next line to write out
+static unsigned int ring_count = 0;  // Lines waiting
+static unsigned int dropped = 0;     // Lines lost because the ring was full
+static int async_running = 0;
+static int stop_requested = 0;
+static int atexit_registered = 0;
+static SDL_mutex *ring_lock = NULL;
+static SDL_cond *ring_ready = NULL;
+static SDL_Thread *writer = NULL;
+
+/**
+ * @brief Writes one line to the stream of its level.
+ * @param level The message level.
+ * @param text The formatted message.
+ * @return Nothing.
+ */
+static void emit(int level, const char *text) {
+    fputs(text, level >= LOG_LEVEL_WARN ? stderr : stdout);
+}
+
+/**
+ * @brief Background thread: moves lines out of the ring and writes them outside the lock.
+ * @param data Unused.
+ * @return 0.
+ */
+static int writer_thread(void *data) {
+    static LogLine batch[LOG_RING_SIZE];
+    (void)data;
+
+    SDL_LockMutex(ring_lock);
+    for (;;) {
+        while (ring_count == 0 && dropped == 0 && !stop_requested) {
+            SDL_CondWait(ring_ready, ring_lock);
+        }
+        if (ring_count == 0 && dropped == 0 && stop_requested) {
+            break;
+        }
+
+        unsigned int n = ring_count;
+        unsigned int lost = dropped;
+        for (unsigned int i = 0; i < n; i++) {
+            batch[i] = ring[(ring_head + i) % LOG_RING_SIZE];
+        }
+        ring_head = (ring_head + n) % LOG_RING_SIZE;
+        ring_count = 0;
+        dropped = 0;
+        SDL_UnlockMutex(ring_lock);
+
+        for (unsigned int i = 0; i < n; i++) {
+            emit(batch[i].level, batch[i].text);
+        }
+        if (lost > 0) {
+            fprintf(stderr, "[log] %u lignes perdues (tampon plein)\n", lost);
+        }
+        fflush(stdout);
+
+        SDL_LockMutex(ring_lock);
+    }
+    SDL_UnlockMutex(ring_lock);
+    fflush(stdout);
+    return 0;
+}
+
+void log_write(int level, const char *fmt, ...) {
+    char text[LOG_LINE_MAX];
+    va_list args;
+
+    va_start(args, fmt);
+    vsnprintf(text, sizeof(text), fmt, args);
+    va_end(args);
+
+    if (!async_running) {
+        emit(level, text);
+        return;
+    }
+
+    int full;
+    SDL_LockMutex(ring_lock);
+    full = ring_count >= LOG_RING_SIZE;
+    if (!full) {
+        LogLine *line = &ring[(ring_head + ring_count) % LOG_RING_SIZE];
+        line->level = level;
+        memcpy(line->text, text, sizeof(text));
+        ring_count++;
+    } else if (level < LOG_LEVEL_WARN) {
+        dropped++; // Never block the game on a slow terminal
+    }
+    SDL_CondSignal(ring_ready);
+    SDL_UnlockMutex(ring_lock);
+
+    if (full && level >= LOG_LEVEL_WARN) {
+        emit(level, text); // Warnings and errors are never dropped
+    }
+}
+
+int log_init(void) {
+    if (!atexit_registered) {
+        atexit(log_shutdown);
+        atexit_registered = 1;
+    }
+#if LOG_ASYNC
+    if (async_running) {
+        return 0;
+    }
+    ring_lock = SDL_CreateMutex();
+    ring_ready = SDL_CreateCond();
+    if (ring_lock == NULL || ring_ready == NULL) {
+        fprintf(stderr, "Impossible de créer le journal asynchrone : %s\n", SDL_GetError());
+        log_shutdown();
+        return -1;
+    }
+    stop_requested = 0;
+    async_running = 1; // Set before the thread exists so no line slips past the ring
+    writer = SDL_CreateThread(writer_thread, NULL);
+    if (writer == NULL) {
+        async_running = 0;
+        fprintf(stderr, "Impossible de démarrer le journal asynchrone : %s\n", SDL_GetError());
+        log_shutdown();
+        return -1;
+    }
+#endif
+    return 0;
+}
+
+void log_shutdown(void) {
+    if (writer) {
+        SDL_LockMutex(ring_lock);
+        stop_requested = 1;
+        SDL_CondSignal(ring_ready);
+        SDL_UnlockMutex(ring_lock);
+        SDL_WaitThread(writer, NULL); // Drains what is left before returning
+        writer = NULL;
+    }
+    async_running = 0;
+    if (ring_ready) {
+        SDL_DestroyCond(ring_ready);
+        ring_ready = NULL;
+    }
+    if (ring_lock) {
+        SDL_DestroyMutex(ring_lock);
+        ring_lock = NULL;
+    }
+    fflush(stdout);
+}
@@ -0,0 +1,87 @@
+/**
+ * @file log.h
+ * @brief Leveled logging macros with a compile-time threshold and an optional asynchronous sink.
+ * @author MohamedNourMraad
+ * @date 2025-05-23
+ * @version 1.0
+ */
+
+#ifndef LOG_H
+#define LOG_H
+
+#define LOG_LEVEL_TRACE 0   // Per-frame details (positions, blits, mouse motion)
+#define LOG_LEVEL_DEBUG 1   // Gameplay events (collisions, state changes, sounds)
+#define LOG_LEVEL_INFO 2    // Loading and initialization
+#define LOG_LEVEL_WARN 3
+#define LOG_LEVEL_ERROR 4
+#define LOG_LEVEL_NONE 5
+
+// Calls below this level are compiled out (set from the Makefile with -DLOG_LEVEL=...)
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_DEBUG
+#endif
+
+// Debug builds write through a ring buffer drained by a background thread
+#ifndef LOG_ASYNC
+#define LOG_ASYNC (LOG_LEVEL <= LOG_LEVEL_DEBUG)
+#endif
+
+#define LOG_RING_SIZE 512    // Lines the asynchronous sink can hold before dropping
+#define LOG_LINE_MAX 256     // Longest line kept, longer lines are truncated
+
+/**
+ * @brief Formats and writes one message: errors and warnings to stderr, the rest to stdout.
+ *        Use the LOG_* macros instead of calling this directly.
+ * @param level One of the LOG_LEVEL_* values.
+ * @param fmt printf-style format.
+ * @return Nothing.
+ */
+void log_write(int level, const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+
+/**
+ * @brief Starts the asynchronous sink when LOG_ASYNC is enabled, and registers
+ *        log_shutdown with atexit so early exits still flush it.
+ * @return 0 on success, -1 if the sink could not start (logging stays synchronous).
+ */
+int log_init(void);
+
+/**
+ * @brief Drains the asynchronous sink and stops its thread. Safe to call twice.
+ * @return Nothing.
+ */
+void log_shutdown(void);
+
+// A disabled call still type-checks its arguments but generates no code
+#define LOG_DISABLED(level, ...) do { if (0) log_write(level, __VA_ARGS__); } while (0)
+
+#if LOG_LEVEL <= LOG_LEVEL_TRACE
+#define LOG_TRACE(...) log_write(LOG_LEVEL_TRACE, __VA_ARGS__)
+#else
+#define LOG_TRACE(...) LOG_DISABLED(LOG_LEVEL_TRACE, __VA_ARGS__)
+#endif
+
+#if LOG_LEVEL <= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(...) log_write(LOG_LEVEL_DEBUG, __VA_ARGS__)
+#else
+#define LOG_DEBUG(...) LOG_DISABLED(LOG_LEVEL_DEBUG, __VA_ARGS__)
+#endif
+
+#if LOG_LEVEL <= LOG_LEVEL_INFO
+#define LOG_INFO(...) log_write(LOG_LEVEL_INFO, __VA_ARGS__)
+#else
+#define LOG_INFO(...) LOG_DISABLED(LOG_LEVEL_INFO, __VA_ARGS__)
+#endif
+
+#if LOG_LEVEL <= LOG_LEVEL_WARN
+#define LOG_WARN(...) log_write(LOG_LEVEL_WARN, __VA_ARGS__)
+#else
+#define LOG_WARN(...) LOG_DISABLED(LOG_LEVEL_WARN, __VA_ARGS__)
+#endif
+
+#if LOG_LEVEL <= LOG_LEVEL_ERROR
+#define LOG_ERROR(...) log_write(LOG_LEVEL_ERROR, __VA_ARGS__)
+#else
+#define LOG_ERROR(...) LOG_DISABLED(LOG_LEVEL_ERROR, __VA_ARGS__)
+#endif
+
+#endif // LOG_H
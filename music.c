@@ -0,0 +1,153 @@
+/**
+ * @file music.c
+ * @brief Streamed music and ambience: long tracks are decoded while they play through
+ *        Mix_Music instead of being held in memory as Mix_Chunk; switching tracks fades.
+ * @author MohamedNourMraad
+ * @date 2025-06-02
+ * @version 1.0
+ */
+
+#include <SDL/SDL.h>
+#include <SDL/SDL_mixer.h>
+#include <stdio.h>
+#include <string.h>
+#include "music.h"
+#include "assets.h"
+#include "log.h"
+
+/**
+ * @brief One opened track. The mixer reads from rw while it plays, so both live together.
+ */
+typedef struct {
+    Mix_Music *music;
+    SDL_RWops *rw;
+    int loops;
+    int fade_ms;
+    char file[MUSIC_NAME_MAX];
+} Track;
+
+static Track current = {0};  // Playing, fading out, or finished
+static Track next = {0};     // Waiting for the current track to fade out
+
+/**
+ * @brief Frees a track and empties it.
+ * @param t The track.
+ * @return Nothing.
+ */
+static void close_track(Track *t) {
+    if (t->music) {
+        Mix_FreeMusic(t->music); // Halts it if it is still playing
+        t->music = NULL;
+    }
+    if (t->rw) {
+        SDL_RWclose(t->rw);
+        t->rw = NULL;
+    }
+    t->file[0] = '\0';
+}
+
+/**
+ * @brief Opens one file as a stream.
+ * @param t The track to fill.
+ * @param file The file name (archive or disk).
+ * @return 0 on success, -1 if the file is missing or not a supported format.
+ */
+static int open_file(Track *t, const char *file) {
+    t->rw = asset_open_rw(file);
+    if (t->rw == NULL) {
+        return -1;
+    }
+    t->music = Mix_LoadMUS_RW(t->rw);
+    if (t->music == NULL) {
+        SDL_RWclose(t->rw);
+        t->rw = NULL;
+        return -1;
+    }
+    snprintf(t->file, sizeof(t->file), "%s", file);
+    return 0;
+}
+
+/**
+ * @brief Opens a track, preferring a compressed version of the file.
+ * @param t The track to fill.
+ * @param file The track file.
+ * @return 0 on success, -1 on failure.
+ */
+static int open_track(Track *t, const char *file) {
+    static const char *const compressed[] = {".ogg", ".mp3"};
+    const char *dot = strrchr(file, '.');
+    int stem = dot ? (int)(dot - file) : (int)strlen(file);
+
+    for (int i = 0; i < 2; i++) {
+        char candidate[MUSIC_NAME_MAX];
+        snprintf(candidate, sizeof(candidate), "%.*s%s", stem, file, compressed[i]);
+        if (strcmp(candidate, file) != 0 && open_file(t, candidate) == 0) {
+            return 0;
+        }
+    }
+    if (open_file(t, file) == 0) {
+        return 0;
+    }
+    LOG_ERROR("Erreur de chargement de la musique %s: %s\n", file, Mix_GetError());
+    return -1;
+}
+
+/**
+ * @brief Makes the waiting track the current one and starts it.
+ * @return 0 on success, -1 if the mixer refused it.
+ */
+static int start_next(void) {
+    close_track(&current);
+    current = next;
+    memset(&next, 0, sizeof(next));
+
+    int started = (current.fade_ms > 0) ? Mix_FadeInMusic(current.music, current.loops, current.fade_ms)
+                                        : Mix_PlayMusic(current.music, current.loops);
+    if (started < 0) {
+        LOG_ERROR("Lecture de %s impossible: %s\n", current.file, Mix_GetError());
+        close_track(&current);
+        return -1;
+    }
+    LOG_DEBUG("Musique %s lancée\n", current.file);
+    return 0;
+}
+
+int music_play(const char *file, int loops, int fade_ms) {
+    close_track(&next); // A newer request replaces one still waiting
+    if (open_track(&next, file) < 0) {
+        return -1;
+    }
+    next.loops = (loops == 0) ? 1 : loops; // Mix_PlayMusic counts plays, not repeats
+    next.fade_ms = fade_ms;
+
+    if (current.music && Mix_PlayingMusic() && fade_ms > 0) {
+        Mix_FadeOutMusic(fade_ms); // music_update starts the new track once this one is silent
+        return 0;
+    }
+    return start_next();
+}
+
+void music_stop(int fade_ms) {
+    close_track(&next);
+    if (fade_ms > 0) {
+        Mix_FadeOutMusic(fade_ms);
+    } else {
+        Mix_HaltMusic();
+    }
+}
+
+int music_playing(void) {
+    return next.music != NULL || Mix_PlayingMusic();
+}
+
+void music_update(void) {
+    if (next.music && !Mix_PlayingMusic()) {
+        start_next();
+    }
+}
+
+void music_close(void) {
+    Mix_HaltMusic();
+    close_track(&next);
+    close_track(&current);
+}
@@ -0,0 +1,54 @@
+/**
+ * @file music.h
+ * @brief Streamed music and ambience: long tracks are decoded while they play through
+ *        Mix_Music instead of being held in memory as Mix_Chunk; switching tracks fades.
+ * @author MohamedNourMraad
+ * @date 2025-06-02
+ * @version 1.0
+ */
+
+#ifndef MUSIC_H
+#define MUSIC_H
+
+#include <SDL/SDL.h>
+
+#define MUSIC_FADE_MS 1500  // Fade out of the old track, then fade in of the new one
+#define MUSIC_NAME_MAX 64   // Longest track file name
+
+/**
+ * @brief Starts a track. If one is playing it fades out first and the new one fades in
+ *        once it has stopped (see music_update). A compressed version of the file
+ *        (same name with .ogg or .mp3) is preferred when it exists, in the archive or on disk.
+ * @param file The track file, e.g. "rome.wav".
+ * @param loops Number of times to play it (-1: forever, 0 and 1: once).
+ * @param fade_ms Fade duration in ms (0: switch immediately).
+ * @return 0 on success, -1 if the track cannot be opened.
+ */
+int music_play(const char *file, int loops, int fade_ms);
+
+/**
+ * @brief Fades out the current track and drops a track waiting for its turn.
+ * @param fade_ms Fade duration in ms (0: stop immediately).
+ * @return Nothing.
+ */
+void music_stop(int fade_ms);
+
+/**
+ * @brief Tells whether music is playing or waiting to start.
+ * @return 1 if so, 0 otherwise.
+ */
+int music_playing(void);
+
+/**
+ * @brief Starts the waiting track once the previous one has faded out. Call once per frame.
+ * @return Nothing.
+ */
+void music_update(void);
+
+/**
+ * @brief Stops the music and frees both tracks. Call before Mix_CloseAudio and asset_close_archive.
+ * @return Nothing.
+ */
+void music_close(void);
+
+#endif // MUSIC_H
@@ -0,0 +1,159 @@
+/**
+ * @file pak.c
+ * @brief Read-only mapping of the asset archive and lookup in its frame table.
+ * @author MohamedNourMraad
+ * @date 2025-05-25
+ * @version 1.0
+ */
+
+#include <SDL/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "pak.h"
+#include "log.h"
+
+static const Uint8 *base = NULL;  // Mapped archive
+static size_t base_size = 0;
+static const PakHeader *header = NULL;
+static const PakPage *pages = NULL;
+static const PakEntry *entries = NULL;
+
+int pak_open(const char *path) {
+    if (base != NULL) {
+        pak_close();
+    }
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return -1;
+    }
+    struct stat st;
+    if (fstat(fd, &st) < 0 || (size_t)st.st_size < sizeof(PakHeader)) {
+        close(fd);
+        LOG_ERROR("Archive %s invalide\n", path);
+        return -1;
+    }
+    void *map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // The mapping stays valid
+    if (map == MAP_FAILED) {
+        LOG_ERROR("Impossible de projeter %s en mémoire\n", path);
+        return -1;
+    }
+
+    const PakHeader *h = map;
+    size_t tables = sizeof(PakHeader) + (size_t)h->page_count * sizeof(PakPage) +
+                    (size_t)h->entry_count * sizeof(PakEntry);
+    if (memcmp(h->magic, PAK_MAGIC, 4) != 0 || h->version != PAK_VERSION || tables > (size_t)st.st_size) {
+        LOG_ERROR("Archive %s invalide ou d'une autre version\n", path);
+        munmap(map, st.st_size);
+        return -1;
+    }
+    const PakPage *p = (const PakPage *)((const Uint8 *)map + sizeof(PakHeader));
+    for (Uint32 i = 0; i < h->page_count; i++) {
+        if (p[i].offset + (size_t)p[i].w * p[i].h * 4 > (size_t)st.st_size) {
+            LOG_ERROR("Archive %s tronquée (page %u)\n", path, i);
+            munmap(map, st.st_size);
+            return -1;
+        }
+    }
+
+    base = map;
+    base_size = st.st_size;
+    header = h;
+    pages = p;
+    entries = (const PakEntry *)(pages + h->page_count);
+    LOG_INFO("Archive %s : %u pages, %u fichiers\n", path, h->page_count, h->entry_count);
+    return 0;
+}
+
+void pak_close(void) {
+    if (base == NULL) {
+        return;
+    }
+    munmap((void *)base, base_size);
+    base = NULL;
+    header = NULL;
+    pages = NULL;
+    entries = NULL;
+}
+
+/**
+ * @brief bsearch comparator between a name and an entry.
+ * @param key The name.
+ * @param entry The entry.
+ * @return strcmp of the two names.
+ */
+static int compare_entry(const void *key, const void *entry) {
+    return strncmp((const char *)key, ((const PakEntry *)entry)->name, PAK_NAME_MAX);
+}
+
+const PakEntry *pak_find(const char *name) {
+    if (base == NULL) {
+        return NULL;
+    }
+    return bsearch(name, entries, header->entry_count, sizeof(PakEntry), compare_entry);
+}
+
+Uint32 pak_page_count(void) {
+    return base ? header->page_count : 0;
+}
+
+const PakPage *pak_page(Uint32 page) {
+    if (base == NULL || page >= header->page_count) {
+        return NULL;
+    }
+    return &pages[page];
+}
+
+/**
+ * @brief Copies a rect of a page into a new writable 32-bit surface.
+ * @param p The page.
+ * @param x The left of the rect.
+ * @param y The top of the rect.
+ * @param w The width of the rect.
+ * @param h The height of the rect.
+ * @return The surface, or NULL on failure.
+ */
+static SDL_Surface *copy_rect(const PakPage *p, int x, int y, int w, int h) {
+    SDL_Surface *copy = SDL_CreateRGBSurface(SDL_SWSURFACE, w, h, 32, PAK_RMASK, PAK_GMASK, PAK_BMASK, PAK_AMASK);
+    if (copy == NULL) {
+        return NULL;
+    }
+    const Uint8 *src = base + p->offset + ((size_t)y * p->w + x) * 4;
+    for (int row = 0; row < h; row++) {
+        memcpy((Uint8 *)copy->pixels + row * copy->pitch, src + (size_t)row * p->w * 4, (size_t)w * 4);
+    }
+    return copy;
+}
+
+SDL_Surface *pak_load_page(Uint32 page) {
+    const PakPage *p = pak_page(page);
+    if (p == NULL) {
+        return NULL;
+    }
+    return copy_rect(p, 0, 0, p->w, p->h);
+}
+
+SDL_Surface *pak_load_image(const char *name) {
+    const PakEntry *e = pak_find(name);
+    if (e == NULL || e->type != PAK_IMAGE) {
+        return NULL;
+    }
+    const PakPage *p = pak_page(e->page);
+    if (p == NULL) {
+        return NULL;
+    }
+    return copy_rect(p, e->x, e->y, e->w, e->h);
+}
+
+SDL_RWops *pak_open_rw(const char *name) {
+    const PakEntry *e = pak_find(name);
+    if (e == NULL || e->type != PAK_RAW || (size_t)e->offset + e->size > base_size) {
+        return NULL;
+    }
+    return SDL_RWFromConstMem(base + e->offset, (int)e->size);
+}
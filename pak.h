@@ -0,0 +1,127 @@
+/**
+ * @file pak.h
+ * @brief Asset archive: sprite atlas pages with a frame table, plus raw files (audio,
+ *        fonts), written offline by tools/packer.c and mapped read-only at runtime.
+ * @author MohamedNourMraad
+ * @date 2025-05-25
+ * @version 1.0
+ */
+
+#ifndef PAK_H
+#define PAK_H
+
+#include <SDL/SDL.h>
+
+#define PAK_FILE "assets.pak"  // Archive looked for at startup; loose files are used without it
+#define PAK_MAGIC "SRPK"
+#define PAK_VERSION 1
+#define PAK_NAME_MAX 48        // Longest file name stored (path relative to the game directory)
+#define PAK_PAGE_SIZE 2048     // Atlas page size; bigger images get a page of their own
+#define PAK_ALIGN 16           // Alignment of page pixels and raw data in the file
+
+// Page pixels are R, G, B, A bytes: the masks of that layout read as a Uint32
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+#define PAK_RMASK 0xff000000
+#define PAK_GMASK 0x00ff0000
+#define PAK_BMASK 0x0000ff00
+#define PAK_AMASK 0x000000ff
+#else
+#define PAK_RMASK 0x000000ff
+#define PAK_GMASK 0x0000ff00
+#define PAK_BMASK 0x00ff0000
+#define PAK_AMASK 0xff000000
+#endif
+
+/**
+ * @brief File header, followed by the page table and the entry table.
+ */
+typedef struct {
+    char magic[4];
+    Uint32 version;
+    Uint32 page_count;
+    Uint32 entry_count;
+} PakHeader;
+
+/**
+ * @brief One atlas page. All images of a page share the same transparency kind
+ *        (ASSET_OPAQUE, ASSET_COLORKEY or ASSET_ALPHA), so a page converts like one image.
+ */
+typedef struct {
+    Uint32 w, h;
+    Uint32 kind;
+    Uint32 offset;  // Pixels, pitch 4 * w
+} PakPage;
+
+typedef enum {
+    PAK_IMAGE,  // A rect of an atlas page
+    PAK_RAW     // Bytes of the original file
+} PakType;
+
+/**
+ * @brief One file of the archive. Entries are sorted by name.
+ */
+typedef struct {
+    char name[PAK_NAME_MAX];
+    Uint32 type;             // PakType
+    Uint32 page;             // PAK_IMAGE: page index
+    Uint16 x, y, w, h;       // PAK_IMAGE: rect in the page
+    Uint32 offset, size;     // PAK_RAW: bytes in the file
+} PakEntry;
+
+/**
+ * @brief Maps an archive. Only one archive is open at a time.
+ * @param path The archive file.
+ * @return 0 on success, -1 if the file is missing or invalid.
+ */
+int pak_open(const char *path);
+
+/**
+ * @brief Unmaps the archive. Surfaces handed out stay valid (they are copies),
+ *        streams opened with pak_open_rw must be closed before.
+ * @return Nothing.
+ */
+void pak_close(void);
+
+/**
+ * @brief Looks a file up in the archive.
+ * @param name The file name, as passed to IMG_Load.
+ * @return The entry, or NULL if no archive is open or the file is not in it.
+ */
+const PakEntry *pak_find(const char *name);
+
+/**
+ * @brief Number of atlas pages.
+ * @return The page count, 0 if no archive is open.
+ */
+Uint32 pak_page_count(void);
+
+/**
+ * @brief Describes an atlas page.
+ * @param page The page index.
+ * @return The page, or NULL if the index is invalid.
+ */
+const PakPage *pak_page(Uint32 page);
+
+/**
+ * @brief Copies a whole atlas page into a new writable 32-bit surface
+ *        (the mapping itself is read-only).
+ * @param page The page index.
+ * @return The surface (freed by the caller), or NULL if the index is invalid.
+ */
+SDL_Surface *pak_load_page(Uint32 page);
+
+/**
+ * @brief Copies one image of the archive into a new writable 32-bit surface.
+ * @param name The file name.
+ * @return The surface (freed by the caller), or NULL if the image is not in the archive.
+ */
+SDL_Surface *pak_load_image(const char *name);
+
+/**
+ * @brief Opens a raw file of the archive as a read-only memory stream.
+ * @param name The file name.
+ * @return The stream, or NULL if the file is not in the archive.
+ */
+SDL_RWops *pak_open_rw(const char *name);
+
+#endif // PAK_H
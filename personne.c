@@ -8,13 +8,19 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <SDL/SDL.h>
 #include <SDL/SDL_image.h>
 #include <SDL/SDL_ttf.h>
 #include <math.h>
 #include "personne.h"
+#include "assets.h"
+#include "dirty.h"
+#include "fonts.h"
+#include "text.h"
 #include "background.h"
-#include "ennemie.h" // Added for Ennemi struct
+#include "log.h"
+#include "input.h"
 
 #define SCREEN_WIDTH 1280  // Screen width
 #define BACKGROUND_WIDTH 2560  // Full background width
@@ -33,6 +39,8 @@ void initialiser_personnage(personnage *p, int use_red_skin) {
     p->acceleration = 0.0;     
     p->up = 0;                 
     p->vy = 0.0;               
+    p->frac_x = 0.0;
+    p->frac_y = 0.0;
     p->status = STAT_SOL;      
     p->vie = 100;                
     p->score = 0;              
@@ -44,21 +52,21 @@ void initialiser_personnage(personnage *p, int use_red_skin) {
     p->shield_active = 0;
     p->shield_timer = 0;
     p->falling = 0;            
-    p->shield_image = IMG_Load("shield.png");
+    asset_load(&p->shield_image, "shield.png");
     if (p->shield_image == NULL) {
-        fprintf(stderr, "Erreur de chargement de l'image du bouclier: %s\n", IMG_GetError());
+        LOG_ERROR("Erreur de chargement de l'image du bouclier: %s\n", IMG_GetError());
     }
 
     p->powerup_notification_active = 0;
     p->powerup_notification_timer = 0;
-    p->powerup_notification_image = IMG_Load("powerup_activated.png");
+    asset_load(&p->powerup_notification_image, "powerup_activated.png");
     if (p->powerup_notification_image == NULL) {
-        fprintf(stderr, "Erreur de chargement de l'image de notification: %s\n", IMG_GetError());
+        LOG_ERROR("Erreur de chargement de l'image de notification: %s\n", IMG_GetError());
     }
 
-    p->guide_images[0] = IMG_Load("guide_player6.png");
+    asset_load(&p->guide_images[0], "guide_player6.png");
     if (p->guide_images[0] == NULL) {
-        fprintf(stderr, "Erreur de chargement de l'image du guide: %s\n", IMG_GetError());
+        LOG_ERROR("Erreur de chargement de l'image du guide: %s\n", IMG_GetError());
     }
 
     char nomFich[30];
@@ -72,99 +80,83 @@ void initialiser_personnage(personnage *p, int use_red_skin) {
     for (int i = 0; i < 8; i++) {
         sprintf(nomFich, "%s%d.png", prefix, i + 1); 
         if (use_red_skin) {
-            p->tab_red_right[i] = IMG_Load(nomFich);
-            if (p->tab_red_right[i] == NULL) {
-                fprintf(stderr, "Erreur de chargement de l'image droite %s: %s\n", nomFich, IMG_GetError());
+            asset_load_sprite(&p->tab_red_right[i], nomFich);
+            if (p->tab_red_right[i].source == NULL) {
+                LOG_ERROR("Erreur de chargement de l'image droite %s: %s\n", nomFich, IMG_GetError());
             }
-            p->tab_right[i] = NULL;
+            p->tab_right[i] = (AssetSprite){0};
         } else {
-            p->tab_right[i] = IMG_Load(nomFich);
-            if (p->tab_right[i] == NULL) {
-                fprintf(stderr, "Erreur de chargement de l'image droite %s: %s\n", nomFich, IMG_GetError());
+            asset_load_sprite(&p->tab_right[i], nomFich);
+            if (p->tab_right[i].source == NULL) {
+                LOG_ERROR("Erreur de chargement de l'image droite %s: %s\n", nomFich, IMG_GetError());
             }
-            p->tab_red_right[i] = NULL;
+            p->tab_red_right[i] = (AssetSprite){0};
         }
     }
    
-    for (int i = 0; i < 8; i++) {
-        sprintf(nomFich, "%s%d_left.png", prefix, i + 1); 
-        if (use_red_skin) {
-            p->tab_red_left[i] = IMG_Load(nomFich);
-            if (p->tab_red_left[i] == NULL) {
-                fprintf(stderr, "Erreur de chargement de l'image gauche %s: %s\n", nomFich, IMG_GetError());
-            }
-            p->tab_left[i] = NULL;
-        } else {
-            p->tab_left[i] = IMG_Load(nomFich);
-            if (p->tab_left[i] == NULL) {
-                fprintf(stderr, "Erreur de chargement de l'image gauche %s: %s\n", nomFich, IMG_GetError());
-            }
-            p->tab_red_left[i] = NULL;
-        }
-    }
-    
     for (int i = 0; i < 6; i++) {
         sprintf(nomFich, "%sattack%d.png", prefix, i + 1); 
         if (use_red_skin) {
-            p->tab_red_attack_right[i] = IMG_Load(nomFich);
-            if (p->tab_red_attack_right[i] == NULL) {
-                fprintf(stderr, "Erreur de chargement de l'image d'attaque droite %s: %s\n", nomFich, IMG_GetError());
+            asset_load_sprite(&p->tab_red_attack_right[i], nomFich);
+            if (p->tab_red_attack_right[i].source == NULL) {
+                LOG_ERROR("Erreur de chargement de l'image d'attaque droite %s: %s\n", nomFich, IMG_GetError());
             }
-            p->tab_attack_right[i] = NULL;
+            p->tab_attack_right[i] = (AssetSprite){0};
         } else {
-            p->tab_attack_right[i] = IMG_Load(nomFich);
-            if (p->tab_attack_right[i] == NULL) {
-                fprintf(stderr, "Erreur de chargement de l'image d'attaque droite %s: %s\n", nomFich, IMG_GetError());
+            asset_load_sprite(&p->tab_attack_right[i], nomFich);
+            if (p->tab_attack_right[i].source == NULL) {
+                LOG_ERROR("Erreur de chargement de l'image d'attaque droite %s: %s\n", nomFich, IMG_GetError());
             }
-            p->tab_red_attack_right[i] = NULL;
-        }
-    }
-    
-    for (int i = 0; i < 6; i++) {
-        sprintf(nomFich, "%sattack%d_left.png", prefix, i + 1); 
-        if (use_red_skin) {
-            p->tab_red_attack_left[i] = IMG_Load(nomFich);
-            if (p->tab_red_attack_left[i] == NULL) {
-                fprintf(stderr, "Erreur de chargement de l'image d'attaque gauche %s: %s\n", nomFich, IMG_GetError());
-            }
-            p->tab_attack_left[i] = NULL;
-        } else {
-            p->tab_attack_left[i] = IMG_Load(nomFich);
-            if (p->tab_attack_left[i] == NULL) {
-                fprintf(stderr, "Erreur de chargement de l'image d'attaque gauche %s: %s\n", nomFich, IMG_GetError());
-            }
-            p->tab_red_attack_left[i] = NULL;
+            p->tab_red_attack_right[i] = (AssetSprite){0};
         }
     }
     
     sprintf(nomFich, "%sjump1.png", prefix); 
     if (use_red_skin) {
-        p->tab_red_jump_right[0] = IMG_Load(nomFich);
-        if (p->tab_red_jump_right[0] == NULL) {
-            fprintf(stderr, "Erreur de chargement de l'image de saut droite %s: %s\n", nomFich, IMG_GetError());
+        asset_load_sprite(&p->tab_red_jump_right[0], nomFich);
+        if (p->tab_red_jump_right[0].source == NULL) {
+            LOG_ERROR("Erreur de chargement de l'image de saut droite %s: %s\n", nomFich, IMG_GetError());
         }
-        p->tab_jump_right[0] = NULL;
+        p->tab_jump_right[0] = (AssetSprite){0};
     } else {
-        p->tab_jump_right[0] = IMG_Load(nomFich);
-        if (p->tab_jump_right[0] == NULL) {
-            fprintf(stderr, "Erreur de chargement de l'image de saut droite %s: %s\n", nomFich, IMG_GetError());
+        asset_load_sprite(&p->tab_jump_right[0], nomFich);
+        if (p->tab_jump_right[0].source == NULL) {
+            LOG_ERROR("Erreur de chargement de l'image de saut droite %s: %s\n", nomFich, IMG_GetError());
         }
-        p->tab_red_jump_right[0] = NULL;
+        p->tab_red_jump_right[0] = (AssetSprite){0};
     }
     
-    sprintf(nomFich, "%sjump1_left.png", prefix); 
-    if (use_red_skin) {
-        p->tab_red_jump_left[0] = IMG_Load(nomFich);
-        if (p->tab_red_jump_left[0] == NULL) {
-            fprintf(stderr, "Erreur de chargement de l'image de saut gauche %s: %s\n", nomFich, IMG_GetError());
+    // Left-facing frames are mirrors of the right-facing ones: the *_left.png files are not read.
+    // All 15 are built in one call, so an atlas page is unpacked once rather than once per frame
+    AssetSprite *left[15];
+    const AssetSprite *right[15];
+    int n = 0;
+    for (int i = 0; i < 8; i++, n++) {
+        left[n] = use_red_skin ? &p->tab_red_left[i] : &p->tab_left[i];
+        right[n] = use_red_skin ? &p->tab_red_right[i] : &p->tab_right[i];
+    }
+    for (int i = 0; i < 6; i++, n++) {
+        left[n] = use_red_skin ? &p->tab_red_attack_left[i] : &p->tab_attack_left[i];
+        right[n] = use_red_skin ? &p->tab_red_attack_right[i] : &p->tab_attack_right[i];
+    }
+    left[n] = use_red_skin ? &p->tab_red_jump_left[0] : &p->tab_jump_left[0];
+    right[n] = use_red_skin ? &p->tab_red_jump_right[0] : &p->tab_jump_right[0];
+    n++;
+    if (asset_mirror_sprites(left, right, n) < n) {
+        for (int i = 0; i < n; i++) {
+            if (left[i]->source == NULL) {
+                LOG_ERROR("Erreur de création de l'image gauche %d\n", i + 1);
+            }
         }
-        p->tab_jump_left[0] = NULL;
+    }
+    if (use_red_skin) {
+        memset(p->tab_left, 0, sizeof(p->tab_left));
+        memset(p->tab_attack_left, 0, sizeof(p->tab_attack_left));
+        memset(p->tab_jump_left, 0, sizeof(p->tab_jump_left));
     } else {
-        p->tab_jump_left[0] = IMG_Load(nomFich);
-        if (p->tab_jump_left[0] == NULL) {
-            fprintf(stderr, "Erreur de chargement de l'image de saut gauche %s: %s\n", nomFich, IMG_GetError());
-        }
-        p->tab_red_jump_left[0] = NULL;
+        memset(p->tab_red_left, 0, sizeof(p->tab_red_left));
+        memset(p->tab_red_attack_left, 0, sizeof(p->tab_red_attack_left));
+        memset(p->tab_red_jump_left, 0, sizeof(p->tab_red_jump_left));
     }
 }
 
@@ -174,116 +166,125 @@ void initialiser_personnage(personnage *p, int use_red_skin) {
  * @return Nothing.
  */
 void liberer_personnage(personnage *p) {
-    if (p->shield_image) SDL_FreeSurface(p->shield_image);
-    if (p->powerup_notification_image) SDL_FreeSurface(p->powerup_notification_image);
-    if (p->guide_images[0]) SDL_FreeSurface(p->guide_images[0]);
+    asset_free(&p->shield_image);
+    asset_free(&p->powerup_notification_image);
+    asset_free(&p->guide_images[0]);
     for (int i = 0; i < 8; i++) {
-        if (p->tab_right[i]) SDL_FreeSurface(p->tab_right[i]);
-        if (p->tab_left[i]) SDL_FreeSurface(p->tab_left[i]);
-        if (p->tab_red_right[i]) SDL_FreeSurface(p->tab_red_right[i]);
-        if (p->tab_red_left[i]) SDL_FreeSurface(p->tab_red_left[i]);
+        asset_free_sprite(&p->tab_right[i]);
+        asset_free_sprite(&p->tab_left[i]);
+        asset_free_sprite(&p->tab_red_right[i]);
+        asset_free_sprite(&p->tab_red_left[i]);
     }
     for (int i = 0; i < 6; i++) {
-        if (p->tab_attack_right[i]) SDL_FreeSurface(p->tab_attack_right[i]);
-        if (p->tab_attack_left[i]) SDL_FreeSurface(p->tab_attack_left[i]);
-        if (p->tab_red_attack_right[i]) SDL_FreeSurface(p->tab_red_attack_right[i]);
-        if (p->tab_red_attack_left[i]) SDL_FreeSurface(p->tab_red_attack_left[i]);
-    }
-    if (p->tab_jump_right[0]) SDL_FreeSurface(p->tab_jump_right[0]);
-    if (p->tab_jump_left[0]) SDL_FreeSurface(p->tab_jump_left[0]);
-    if (p->tab_red_jump_right[0]) SDL_FreeSurface(p->tab_red_jump_right[0]);
-    if (p->tab_red_jump_left[0]) SDL_FreeSurface(p->tab_red_jump_left[0]);
+        asset_free_sprite(&p->tab_attack_right[i]);
+        asset_free_sprite(&p->tab_attack_left[i]);
+        asset_free_sprite(&p->tab_red_attack_right[i]);
+        asset_free_sprite(&p->tab_red_attack_left[i]);
+    }
+    asset_free_sprite(&p->tab_jump_right[0]);
+    asset_free_sprite(&p->tab_jump_left[0]);
+    asset_free_sprite(&p->tab_red_jump_right[0]);
+    asset_free_sprite(&p->tab_red_jump_left[0]);
 }
 
 /**
- * @brief Displays a character on the screen.
- * @param p The character structure.
- * @param ecran The SDL surface to render on.
+ * @brief Queues the sprite and shield of a character for drawing if they are on screen.
+ * @param p Pointer to the character (read only).
+ * @param pos World position to draw at (interpolated by the caller; p->position is not read).
+ * @param ctx Render context (screen, camera and draw list).
  * @return Nothing.
  */
-void afficher_personnage(personnage p, SDL_Surface *ecran) {
-    SDL_Surface *current_frame = NULL;
+void afficher_personnage(const personnage *p, const SDL_Rect *pos, RenderCtx *ctx) {
+    const AssetSprite *current_frame = NULL;
 
-    if (p.status == STAT_ATTACK) {
-        if (p.direction >= 0) { 
-            if (p.use_red_skin) {
-                current_frame = p.tab_red_attack_right[p.attack_frame];
+    if (p->status == STAT_ATTACK) {
+        if (p->direction >= 0) { 
+            if (p->use_red_skin) {
+                current_frame = &p->tab_red_attack_right[p->attack_frame];
             } else {
-                current_frame = p.tab_attack_right[p.attack_frame];
+                current_frame = &p->tab_attack_right[p->attack_frame];
             }
         } else { 
-            if (p.use_red_skin) {
-                current_frame = p.tab_red_attack_left[p.attack_frame];
+            if (p->use_red_skin) {
+                current_frame = &p->tab_red_attack_left[p->attack_frame];
             } else {
-                current_frame = p.tab_attack_left[p.attack_frame];
+                current_frame = &p->tab_attack_left[p->attack_frame];
             }
         }
-    } else if (p.status == STAT_AIR || p.falling) {
-        if (p.direction >= 0) {
-            if (p.use_red_skin) {
-                current_frame = p.tab_red_jump_right[p.jump_frame];
+    } else if (p->status == STAT_AIR || p->falling) {
+        if (p->direction >= 0) {
+            if (p->use_red_skin) {
+                current_frame = &p->tab_red_jump_right[p->jump_frame];
             } else {
-                current_frame = p.tab_jump_right[p.jump_frame];
+                current_frame = &p->tab_jump_right[p->jump_frame];
             }
         } else {
-            if (p.use_red_skin) {
-                current_frame = p.tab_red_jump_left[p.jump_frame];
+            if (p->use_red_skin) {
+                current_frame = &p->tab_red_jump_left[p->jump_frame];
             } else {
-                current_frame = p.tab_jump_left[p.jump_frame];
+                current_frame = &p->tab_jump_left[p->jump_frame];
             }
         }
     } else {
-        if (p.direction >= 0) { 
-            if (p.use_red_skin) {
-                current_frame = p.tab_red_right[p.frame];
+        if (p->direction >= 0) { 
+            if (p->use_red_skin) {
+                current_frame = &p->tab_red_right[p->frame];
             } else {
-                current_frame = p.tab_right[p.frame];
+                current_frame = &p->tab_right[p->frame];
             }
         } else { 
-            if (p.use_red_skin) {
-                current_frame = p.tab_red_left[p.frame];
+            if (p->use_red_skin) {
+                current_frame = &p->tab_red_left[p->frame];
             } else {
-                current_frame = p.tab_left[p.frame];
+                current_frame = &p->tab_left[p->frame];
             }
         }
     }
 
-    if (current_frame) {
-        SDL_BlitSurface(current_frame, NULL, ecran, &p.position);
+    if (current_frame && current_frame->source) {
+        draw_sprite_world(ctx, *current_frame->source, &current_frame->rect, pos);
     } else {
-        fprintf(stderr, "Aucune surface à afficher pour frame %d, attack_frame %d, jump_frame %d, status %d, direction %d, red_skin %d\n", 
-                p.frame, p.attack_frame, p.jump_frame, p.status, p.direction, p.use_red_skin);
+        LOG_ERROR("Aucune surface à afficher pour frame %d, attack_frame %d, jump_frame %d, status %d, direction %d, red_skin %d\n", 
+                p->frame, p->attack_frame, p->jump_frame, p->status, p->direction, p->use_red_skin);
     }
 
-    if (p.shield_active && p.shield_image) {
-        SDL_BlitSurface(p.shield_image, NULL, ecran, &p.position);
+    if (p->shield_active && p->shield_image) {
+        draw_sprite_world(ctx, p->shield_image, NULL, pos);
     }
+}
+
+/**
+ * @brief Draws what follows a character on top of the world: power-up notification,
+ *        shield timer and guide. Call it after the world sprites were flushed.
+ * @param p Pointer to the character (read only).
+ * @param pos World position the character was drawn at (see afficher_personnage).
+ * @param ctx Render context (screen and camera).
+ * @return Nothing.
+ */
+void afficher_hud_personnage(const personnage *p, const SDL_Rect *pos, const RenderCtx *ctx) {
+    SDL_Surface *ecran = ctx->screen;
+    int screen_x = render_screen_x(ctx, pos->x);
+    int screen_y = render_screen_y(ctx, pos->y);
 
-    if (p.powerup_notification_active && p.powerup_notification_image) {
-        SDL_Rect notification_pos = {p.position.x + 10, p.position.y - 150, 0, 0};
-        SDL_BlitSurface(p.powerup_notification_image, NULL, ecran, &notification_pos);
+    if (p->powerup_notification_active && p->powerup_notification_image) {
+        SDL_Rect notification_pos = {screen_x + 10, screen_y - 150, 0, 0};
+        dirty_blit(p->powerup_notification_image, NULL, ecran, &notification_pos);
     }
 
-    if (p.shield_active) {
-        Uint32 remaining_time = (p.shield_timer - SDL_GetTicks()) / 1000;
-        char timer_text[32];
-        sprintf(timer_text, "Shield: %ds", remaining_time);
+    if (p->shield_active) {
+        Uint32 remaining_time = (p->shield_timer - input_ticks()) / 1000;
         SDL_Color white = {255, 255, 255, 0};
-        TTF_Font *font = TTF_OpenFont("arial.ttf", 24);
+        TTF_Font *font = font_get(FONT_HUD_FILE, FONT_HUD_SIZE); // Borrowed, opened once
         if (font) {
-            SDL_Surface *timer_surface = TTF_RenderText_Solid(font, timer_text, white);
-            if (timer_surface) {
-                SDL_Rect timer_pos = {p.position.x + 30, p.position.y - 30, 0, 0};
-                SDL_BlitSurface(timer_surface, NULL, ecran, &timer_pos);
-                SDL_FreeSurface(timer_surface);
-            }
-            TTF_CloseFont(font);
+            SDL_Rect timer_pos = {screen_x + 30, screen_y - 30, 0, 0};
+            int w = text_draw_labeled_number(ecran, font, "Shield:", (int)remaining_time, white, timer_pos.x, timer_pos.y);
+            text_draw(ecran, font, "s", white, timer_pos.x + w, timer_pos.y);
         }
     }
 
-    if (p.show_guide && p.guide_images[0]) {
+    if (p->show_guide && p->guide_images[0]) {
         SDL_Rect guide_pos = {180, 20, 0, 0}; // Adjust position as needed
-        SDL_BlitSurface(p.guide_images[0], NULL, ecran, &guide_pos);
+        dirty_blit(p->guide_images[0], NULL, ecran, &guide_pos);
     }
 }
 
@@ -308,12 +309,12 @@ void movePerso(personnage *p, Uint32 dt, Background *bg) {
     const double max_speed = 200.0;
     const double sprint_speed = 400.0;
     const double gravity = 500.0;
-    const double max_fall_speed = 300.0; // Cap falling speed to prevent tunneling
+    const double max_fall_speed = 900.0; // Terminal velocity; collision is swept, so no tunneling
     static Uint32 last_anim_time = 0;
     const Uint32 anim_interval = 100;
 
     double current_max_speed = max_speed;
-    Uint8 *keystate = SDL_GetKeyState(NULL);
+    Uint8 *keystate = input_key_state();
     if (keystate[SDLK_LSHIFT] || keystate[SDLK_RSHIFT]) {
         current_max_speed = sprint_speed;
     }
@@ -322,7 +323,10 @@ void movePerso(personnage *p, Uint32 dt, Background *bg) {
     if (p->vitesse > current_max_speed) p->vitesse = current_max_speed;
     if (p->vitesse < -current_max_speed) p->vitesse = -current_max_speed;
     
-    p->position.x += p->vitesse * dt_seconds;
+    // Carry the fraction of a pixel so short simulation steps do not lose speed
+    double new_x = p->position.x + p->frac_x + p->vitesse * dt_seconds;
+    p->position.x = (int)floor(new_x);
+    p->frac_x = new_x - p->position.x;
 
     // Keep player within the full background bounds, not the screen width
     if (p->position.x < 0) p->position.x = 0;
@@ -333,12 +337,15 @@ void movePerso(personnage *p, Uint32 dt, Background *bg) {
     int platform_y = -1;
 
     if (p->status == STAT_AIR || p->falling) {
+        int prev_y = p->position.y;
         p->vy += gravity * dt_seconds;
         if (p->vy > max_fall_speed) p->vy = max_fall_speed; // Cap fall speed
-        p->position.y += p->vy * dt_seconds;
+        double new_y = p->position.y + p->frac_y + p->vy * dt_seconds;
+        p->position.y = (int)floor(new_y);
+        p->frac_y = new_y - p->position.y;
 
-        // Check collision after moving
-        should_fall = check_collision(*bg, p->position.x, p->position.y, 170, 170, &is_obstacle, p->status, p->vy, &platform_y);
+        // Check collision over every row crossed by the feet during this move
+        should_fall = check_collision_swept(bg, p->position.x, prev_y, p->position.y, 170, 170, &is_obstacle, p->status, p->vy, &platform_y);
         if (!should_fall && !p->falling && p->status != STAT_AIR) {
             // Landed on pink platform
             p->vy = 0.0;
@@ -353,7 +360,7 @@ void movePerso(personnage *p, Uint32 dt, Background *bg) {
             p->falling = 0;
             p->up = 0;
             p->jump_frame = 0;
-            printf("Snapped to platform at y=%d\n", platform_y);
+            LOG_DEBUG("Snapped to platform at y=%d\n", platform_y);
         }
         // Check if player falls off screen
         if (p->position.y > 754) {
@@ -371,7 +378,7 @@ void movePerso(personnage *p, Uint32 dt, Background *bg) {
 
     // Check for collision when on ground
     if (p->status == STAT_SOL && !p->falling) {
-        should_fall = check_collision(*bg, p->position.x, p->position.y, 170, 170, &is_obstacle, p->status, p->vy, &platform_y);
+        should_fall = check_collision(bg, p->position.x, p->position.y, 170, 170, &is_obstacle, p->status, p->vy, &platform_y);
         if (should_fall) {
             p->falling = 1;
             p->status = STAT_AIR;
@@ -392,7 +399,7 @@ void movePerso(personnage *p, Uint32 dt, Background *bg) {
         p->jump_frame = 0;
     }
 
-    Uint32 current_time = SDL_GetTicks();
+    Uint32 current_time = input_ticks();
     if (p->status == STAT_ATTACK) {
         if (current_time - last_anim_time >= anim_interval) {
             p->attack_frame++;
@@ -414,7 +421,7 @@ void movePerso(personnage *p, Uint32 dt, Background *bg) {
         p->frame = 0;
     }
 
-    printf("Joueur: vitesse=%.2f, x=%d, y=%d, vy=%.2f, accel=%.2f, frame=%d, attack_frame=%d, jump_frame=%d, status=%d, dir=%d, red_skin=%d, falling=%d\n", 
+    LOG_TRACE("Joueur: vitesse=%.2f, x=%d, y=%d, vy=%.2f, accel=%.2f, frame=%d, attack_frame=%d, jump_frame=%d, status=%d, dir=%d, red_skin=%d, falling=%d\n", 
            p->vitesse, p->position.x, p->position.y, p->vy, p->acceleration, p->frame, p->attack_frame, p->jump_frame, p->status, p->direction, p->use_red_skin, p->falling);
 }
 
@@ -439,7 +446,7 @@ void handle_input(SDL_Event event, personnage *p1, personnage *p2, int *running,
         return;
     }
 
-    Uint8 *keystate = SDL_GetKeyState(NULL);
+    Uint8 *keystate = input_key_state();
     double accel_value = accel;
     if (keystate[SDLK_LSHIFT] || keystate[SDLK_RSHIFT]) {
         accel_value = sprint_accel;
@@ -562,10 +569,10 @@ void handle_input(SDL_Event event, personnage *p1, personnage *p2, int *running,
 void activate_shield(personnage *p) {
     if (!p->shield_active) {
         p->shield_active = 1;
-        p->shield_timer = SDL_GetTicks() + 15000;
+        p->shield_timer = input_ticks() + 15000;
 
         p->powerup_notification_active = 1;
-        p->powerup_notification_timer = SDL_GetTicks() + 3000;
+        p->powerup_notification_timer = input_ticks() + 3000;
     }
 }
 
@@ -575,34 +582,11 @@ void activate_shield(personnage *p) {
  * @return Nothing.
  */
 void update_shield(personnage *p) {
-    if (p->shield_active && SDL_GetTicks() >= p->shield_timer) {
+    if (p->shield_active && input_ticks() >= p->shield_timer) {
         p->shield_active = 0;
     }
 
-    if (p->powerup_notification_active && SDL_GetTicks() >= p->powerup_notification_timer) {
+    if (p->powerup_notification_active && input_ticks() >= p->powerup_notification_timer) {
         p->powerup_notification_active = 0;
     }
 }
-
-/**
- * @brief Checks if a player collides with the treasure.
- * @param p Pointer to the character structure.
- * @param es Pointer to the enemy structure containing treasure data.
- * @return 1 if collision detected, 0 otherwise.
- */
-int check_collision_with_treasure(personnage *p, Ennemi *es) {
-    if (!p || !es) return 0;
-
-    SDL_Rect playerRect = {p->position.x, p->position.y, 170, 170}; // Player size from movePerso
-    SDL_Rect treasureRect = es->positionES5;
-
-    if (playerRect.x < treasureRect.x + treasureRect.w &&
-        playerRect.x + playerRect.w > treasureRect.x &&
-        playerRect.y < treasureRect.y + treasureRect.h &&
-        playerRect.y + playerRect.h > treasureRect.y) {
-        printf("Collision detected between player at (%d, %d) and treasure at (%d, %d)\n",
-               playerRect.x, playerRect.y, treasureRect.x, treasureRect.y);
-        return 1;
-    }
-    return 0;
-}
@@ -14,6 +14,8 @@
 #include <SDL/SDL_mixer.h> // Ajouté pour le son
 #include "background.h"
 #include "ennemie.h"
+#include "render.h"
+#include "assets.h"
 
 #define STAT_SOL 0
 #define STAT_AIR 1
@@ -26,24 +28,25 @@ typedef struct {
     double acceleration;
     int up;
     double vy;
+    double frac_x, frac_y; // Sub-pixel movement not yet applied to position
     int status;
     int vie;
     int score;
     int direction;
     int attack_frame;
     int jump_frame;
-    SDL_Surface *tab_right[8];
-    SDL_Surface *tab_left[8];
-    SDL_Surface *tab_attack_right[6];
-    SDL_Surface *tab_attack_left[6];
-    SDL_Surface *tab_jump_right[1];
-    SDL_Surface *tab_jump_left[1];
-    SDL_Surface *tab_red_right[8];
-    SDL_Surface *tab_red_left[8];
-    SDL_Surface *tab_red_attack_right[6];
-    SDL_Surface *tab_red_attack_left[6];
-    SDL_Surface *tab_red_jump_right[1];
-    SDL_Surface *tab_red_jump_left[1];
+    AssetSprite tab_right[8];
+    AssetSprite tab_left[8];
+    AssetSprite tab_attack_right[6];
+    AssetSprite tab_attack_left[6];
+    AssetSprite tab_jump_right[1];
+    AssetSprite tab_jump_left[1];
+    AssetSprite tab_red_right[8];
+    AssetSprite tab_red_left[8];
+    AssetSprite tab_red_attack_right[6];
+    AssetSprite tab_red_attack_left[6];
+    AssetSprite tab_red_jump_right[1];
+    AssetSprite tab_red_jump_left[1];
     int use_red_skin;
     int show_guide;
     SDL_Surface *guide_images[6]; // Images de guide
@@ -60,13 +63,13 @@ typedef struct {
 } personnage;
 
 void initialiser_personnage(personnage *p, int use_red_skin);
-void afficher_personnage(personnage p, SDL_Surface *ecran);
+void afficher_personnage(const personnage *p, const SDL_Rect *pos, RenderCtx *ctx);
+void afficher_hud_personnage(const personnage *p, const SDL_Rect *pos, const RenderCtx *ctx);
 void animate_personnage(personnage *p);
 void movePerso(personnage *p, Uint32 dt, Background *bg);
 void handle_input(SDL_Event event, personnage *p1, personnage *p2, int *running, int active_player, int game_mode, Background *bg);
 void activate_shield(personnage *p);
 void update_shield(personnage *p);
-int check_collision_with_treasure(personnage *p, Ennemi *es);
 void liberer_personnage(personnage *p); // Pour libérer les ressources
 
 #endif
@@ -0,0 +1,350 @@
+/**
+ * @file profiler.c
+ * @brief Frame profiler: per-phase timings with min/avg/p99, per-frame counters,
+ *        an F3 overlay and a CSV/JSON dump.
+ * @author MohamedNourMraad
+ * @date 2025-05-24
+ * @version 1.0
+ */
+
+#include <SDL/SDL.h>
+#include <SDL/SDL_ttf.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "profiler.h"
+#include "fonts.h"
+#include "text.h"
+#include "log.h"
+
+#if PROFILER_ENABLED
+
+/**
+ * @brief Distribution of one phase over many frames.
+ */
+typedef struct {
+    Uint32 count;
+    Uint64 sum_ns;
+    Uint64 min_ns;
+    Uint64 max_ns;
+    Uint32 hist[PROFILER_BUCKETS];
+} PhaseStats;
+
+/**
+ * @brief Values shown by the overlay, refreshed once per window.
+ */
+typedef struct {
+    Uint32 min_us;
+    Uint32 avg_us;
+    Uint32 p99_us;
+} PhaseSummary;
+
+/**
+ * @brief Distribution of one counter over many frames.
+ */
+typedef struct {
+    Uint32 count;
+    Uint64 sum;
+    Uint32 min;
+    Uint32 max;
+} CounterStats;
+
+/**
+ * @brief Counter values shown by the overlay, refreshed once per window.
+ */
+typedef struct {
+    Uint32 min;
+    Uint32 avg;
+    Uint32 max;
+} CounterSummary;
+
+static const char *phase_names[PROF_COUNT] = {
+    "frame", "input", "players", "enemy_ai", "gameplay", "background", "sprites", "hud", "flip"
+};
+
+static const char *counter_names[PROF_COUNTER_COUNT] = {
+    "sprites_drawn", "sprites_culled"
+};
+
+static PhaseStats lifetime[PROF_COUNT];
+static PhaseStats window[PROF_COUNT];
+static PhaseSummary shown[PROF_COUNT];
+static Uint64 frame_ns[PROF_COUNT];   // Exclusive time of each phase in the current frame
+static Uint64 started_ns[PROF_COUNT]; // When the phase last started or resumed
+static ProfPhase stack[PROFILER_MAX_DEPTH];
+static int depth = 0;
+static int frame_open = 0;
+static Uint32 window_start = 0;
+static int overlay_visible = 0;
+static CounterStats counter_lifetime[PROF_COUNTER_COUNT];
+static CounterStats counter_window[PROF_COUNTER_COUNT];
+static CounterSummary counter_shown[PROF_COUNTER_COUNT];
+static Uint32 frame_counters[PROF_COUNTER_COUNT]; // Counters of the current frame
+
+/**
+ * @brief Reads the monotonic clock.
+ * @return The current time in nanoseconds.
+ */
+static Uint64 now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (Uint64)ts.tv_sec * 1000000000ULL + (Uint64)ts.tv_nsec;
+}
+
+/**
+ * @brief Adds one sample to a distribution.
+ * @param stats The distribution.
+ * @param ns The sample in nanoseconds.
+ * @return Nothing.
+ */
+static void stats_add(PhaseStats *stats, Uint64 ns) {
+    Uint64 bucket = ns / (PROFILER_BUCKET_US * 1000ULL);
+    if (bucket >= PROFILER_BUCKETS) {
+        bucket = PROFILER_BUCKETS - 1;
+    }
+    if (stats->count == 0 || ns < stats->min_ns) stats->min_ns = ns;
+    if (ns > stats->max_ns) stats->max_ns = ns;
+    stats->count++;
+    stats->sum_ns += ns;
+    stats->hist[bucket]++;
+}
+
+/**
+ * @brief Adds the value a counter reached in one frame to a distribution.
+ * @param stats The distribution.
+ * @param value The counter at the end of the frame.
+ * @return Nothing.
+ */
+static void counter_add(CounterStats *stats, Uint32 value) {
+    if (stats->count == 0 || value < stats->min) stats->min = value;
+    if (value > stats->max) stats->max = value;
+    stats->count++;
+    stats->sum += value;
+}
+
+/**
+ * @brief Computes the 99th percentile from the histogram.
+ * @param stats The distribution.
+ * @return The upper bound of the bucket holding the 99th percentile (capped by the
+ *         maximum), in microseconds.
+ */
+static Uint32 stats_p99_us(const PhaseStats *stats) {
+    Uint32 target = stats->count - stats->count / 100; // ceil(0.99 * count) for integer counts
+    Uint32 max_us = (Uint32)(stats->max_ns / 1000);
+    Uint32 seen = 0;
+    for (int i = 0; i < PROFILER_BUCKETS; i++) {
+        seen += stats->hist[i];
+        if (seen >= target) {
+            Uint32 upper = (Uint32)(i + 1) * PROFILER_BUCKET_US;
+            return upper < max_us ? upper : max_us;
+        }
+    }
+    return max_us;
+}
+
+/**
+ * @brief Summarizes the current window for the overlay and starts a new one.
+ * @return Nothing.
+ */
+static void close_window(void) {
+    for (int i = 0; i < PROF_COUNT; i++) {
+        PhaseStats *w = &window[i];
+        if (w->count > 0) {
+            shown[i].min_us = (Uint32)(w->min_ns / 1000);
+            shown[i].avg_us = (Uint32)(w->sum_ns / w->count / 1000);
+            shown[i].p99_us = stats_p99_us(w);
+        }
+        memset(w, 0, sizeof(*w));
+    }
+    for (int i = 0; i < PROF_COUNTER_COUNT; i++) {
+        CounterStats *w = &counter_window[i];
+        if (w->count > 0) {
+            counter_shown[i].min = w->min;
+            counter_shown[i].avg = (Uint32)(w->sum / w->count);
+            counter_shown[i].max = w->max;
+        }
+        memset(w, 0, sizeof(*w));
+    }
+}
+
+void profiler_frame_begin(void) {
+    memset(frame_ns, 0, sizeof(frame_ns));
+    memset(frame_counters, 0, sizeof(frame_counters));
+    depth = 0; // A frame left by `continue` may not have closed its phases
+    frame_open = 1;
+    started_ns[PROF_FRAME] = now_ns();
+    if (window_start == 0) {
+        window_start = SDL_GetTicks();
+    }
+}
+
+void profiler_frame_end(void) {
+    if (!frame_open) {
+        return;
+    }
+    Uint64 now = now_ns();
+    while (depth > 0) {
+        profiler_end(stack[depth - 1]);
+    }
+    frame_ns[PROF_FRAME] = now - started_ns[PROF_FRAME];
+    frame_open = 0;
+
+    for (int i = 0; i < PROF_COUNT; i++) {
+        stats_add(&lifetime[i], frame_ns[i]);
+        stats_add(&window[i], frame_ns[i]);
+    }
+    for (int i = 0; i < PROF_COUNTER_COUNT; i++) {
+        counter_add(&counter_lifetime[i], frame_counters[i]);
+        counter_add(&counter_window[i], frame_counters[i]);
+    }
+    if (SDL_GetTicks() - window_start >= PROFILER_WINDOW_MS) {
+        close_window();
+        window_start = SDL_GetTicks();
+    }
+}
+
+void profiler_discard_frame(void) {
+    frame_open = 0;
+    depth = 0;
+}
+
+void profiler_begin(ProfPhase phase) {
+    if (!frame_open || depth >= PROFILER_MAX_DEPTH) {
+        return;
+    }
+    Uint64 now = now_ns();
+    if (depth > 0) {
+        ProfPhase parent = stack[depth - 1];
+        frame_ns[parent] += now - started_ns[parent]; // Pause the enclosing phase
+    }
+    stack[depth++] = phase;
+    started_ns[phase] = now;
+}
+
+void profiler_end(ProfPhase phase) {
+    if (!frame_open || depth == 0 || stack[depth - 1] != phase) {
+        return;
+    }
+    Uint64 now = now_ns();
+    frame_ns[phase] += now - started_ns[phase];
+    depth--;
+    if (depth > 0) {
+        started_ns[stack[depth - 1]] = now; // Resume the enclosing phase
+    }
+}
+
+void profiler_count(ProfCounter counter, Uint32 n) {
+    if (frame_open) {
+        frame_counters[counter] += n;
+    }
+}
+
+void profiler_toggle_overlay(void) {
+    overlay_visible = !overlay_visible;
+}
+
+void profiler_draw_overlay(SDL_Surface *screen, int x, int y) {
+    if (!overlay_visible || screen == NULL) {
+        return;
+    }
+    TTF_Font *font = font_get(FONT_HUD_FILE, PROFILER_FONT_SIZE);
+    if (font == NULL) {
+        return;
+    }
+    SDL_Color yellow = {255, 255, 0, 0};
+    int line_h = TTF_FontLineSkip(font);
+    int col_min = x + 130, col_avg = x + 190, col_p99 = x + 250;
+
+    text_draw(screen, font, "phase (us)", yellow, x, y);
+    text_draw(screen, font, "min", yellow, col_min, y);
+    text_draw(screen, font, "avg", yellow, col_avg, y);
+    text_draw(screen, font, "p99", yellow, col_p99, y);
+    for (int i = 0; i < PROF_COUNT; i++) {
+        int row = y + (i + 1) * line_h;
+        text_draw(screen, font, phase_names[i], yellow, x, row);
+        text_draw_number(screen, font, (int)shown[i].min_us, yellow, col_min, row);
+        text_draw_number(screen, font, (int)shown[i].avg_us, yellow, col_avg, row);
+        text_draw_number(screen, font, (int)shown[i].p99_us, yellow, col_p99, row);
+    }
+
+    int counters_y = y + (PROF_COUNT + 1) * line_h;
+    text_draw(screen, font, "count", yellow, x, counters_y);
+    text_draw(screen, font, "min", yellow, col_min, counters_y);
+    text_draw(screen, font, "avg", yellow, col_avg, counters_y);
+    text_draw(screen, font, "max", yellow, col_p99, counters_y);
+    for (int i = 0; i < PROF_COUNTER_COUNT; i++) {
+        int row = counters_y + (i + 1) * line_h;
+        text_draw(screen, font, counter_names[i], yellow, x, row);
+        text_draw_number(screen, font, (int)counter_shown[i].min, yellow, col_min, row);
+        text_draw_number(screen, font, (int)counter_shown[i].avg, yellow, col_avg, row);
+        text_draw_number(screen, font, (int)counter_shown[i].max, yellow, col_p99, row);
+    }
+}
+
+int profiler_dump(const char *base) {
+    char path[256];
+    int status = 0;
+
+    snprintf(path, sizeof(path), "%s.csv", base);
+    FILE *csv = fopen(path, "w");
+    if (csv == NULL) {
+        LOG_ERROR("Impossible d'écrire %s\n", path);
+        status = -1;
+    } else {
+        fprintf(csv, "phase,frames,min_us,avg_us,p99_us,max_us\n");
+        for (int i = 0; i < PROF_COUNT; i++) {
+            const PhaseStats *s = &lifetime[i];
+            fprintf(csv, "%s,%u,%llu,%llu,%u,%llu\n", phase_names[i], s->count,
+                    (unsigned long long)(s->min_ns / 1000),
+                    (unsigned long long)(s->count ? s->sum_ns / s->count / 1000 : 0),
+                    s->count ? stats_p99_us(s) : 0,
+                    (unsigned long long)(s->max_ns / 1000));
+        }
+        fprintf(csv, "\ncounter,frames,min,avg,max,total\n");
+        for (int i = 0; i < PROF_COUNTER_COUNT; i++) {
+            const CounterStats *c = &counter_lifetime[i];
+            fprintf(csv, "%s,%u,%u,%llu,%u,%llu\n", counter_names[i], c->count, c->min,
+                    (unsigned long long)(c->count ? c->sum / c->count : 0), c->max,
+                    (unsigned long long)c->sum);
+        }
+        fclose(csv);
+    }
+
+    snprintf(path, sizeof(path), "%s.json", base);
+    FILE *json = fopen(path, "w");
+    if (json == NULL) {
+        LOG_ERROR("Impossible d'écrire %s\n", path);
+        return -1;
+    }
+    fprintf(json, "{\n  \"bucket_us\": %d,\n  \"phases\": [\n", PROFILER_BUCKET_US);
+    for (int i = 0; i < PROF_COUNT; i++) {
+        const PhaseStats *s = &lifetime[i];
+        fprintf(json, "    {\"name\": \"%s\", \"frames\": %u, \"min_us\": %llu, \"avg_us\": %llu, \"p99_us\": %u, \"max_us\": %llu, \"histogram\": [",
+                phase_names[i], s->count,
+                (unsigned long long)(s->min_ns / 1000),
+                (unsigned long long)(s->count ? s->sum_ns / s->count / 1000 : 0),
+                s->count ? stats_p99_us(s) : 0,
+                (unsigned long long)(s->max_ns / 1000));
+        int first = 1;
+        for (int b = 0; b < PROFILER_BUCKETS; b++) {
+            if (s->hist[b] == 0) continue; // Only non-empty buckets: [start_us, count]
+            fprintf(json, "%s[%d, %u]", first ? "" : ", ", b * PROFILER_BUCKET_US, s->hist[b]);
+            first = 0;
+        }
+        fprintf(json, "]}%s\n", i + 1 < PROF_COUNT ? "," : "");
+    }
+    fprintf(json, "  ],\n  \"counters\": [\n");
+    for (int i = 0; i < PROF_COUNTER_COUNT; i++) {
+        const CounterStats *c = &counter_lifetime[i];
+        fprintf(json, "    {\"name\": \"%s\", \"frames\": %u, \"min\": %u, \"avg\": %llu, \"max\": %u, \"total\": %llu}%s\n",
+                counter_names[i], c->count, c->min,
+                (unsigned long long)(c->count ? c->sum / c->count : 0), c->max,
+                (unsigned long long)c->sum, i + 1 < PROF_COUNTER_COUNT ? "," : "");
+    }
+    fprintf(json, "  ]\n}\n");
+    fclose(json);
+    LOG_INFO("Profil écrit dans %s.csv et %s.json\n", base, base);
+    return status;
+}
+
+#endif // PROFILER_ENABLED
@@ -0,0 +1,135 @@
+/**
+ * @file profiler.h
+ * @brief Frame profiler: per-phase timings with min/avg/p99, per-frame counters,
+ *        an F3 overlay and a CSV/JSON dump.
+ * @author MohamedNourMraad
+ * @date 2025-05-24
+ * @version 1.0
+ */
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <SDL/SDL.h>
+
+// Compile with -DPROFILER_ENABLED=0 to remove every PROF_* call
+#ifndef PROFILER_ENABLED
+#define PROFILER_ENABLED 1
+#endif
+
+#define PROFILER_BUCKET_US 20     // Histogram resolution
+#define PROFILER_BUCKETS 2500     // 2500 x 20 us = 50 ms, longer samples land in the last bucket
+#define PROFILER_WINDOW_MS 1000   // The overlay shows the statistics of the last complete window
+#define PROFILER_MAX_DEPTH 8      // Nested phases
+#define PROFILER_FONT_SIZE 16
+
+/**
+ * @brief Measured phases. Nested phases are exclusive: time spent in a child
+ *        is not counted in its parent. PROF_FRAME is the whole frame, sleep excluded.
+ */
+typedef enum {
+    PROF_FRAME,
+    PROF_INPUT,       // SDL_PollEvent and handle_input
+    PROF_PLAYERS,     // movePerso and update_shield, all simulation steps
+    PROF_ENEMY_AI,    // Enemy state, movement and animation, all simulation steps
+    PROF_GAMEPLAY,    // Pickups, checkPlayerES*Collision, timers, level transition
+    PROF_BACKGROUND,  // display_background (the door is queued with the sprites)
+    PROF_SPRITES,     // Door, props, enemies, players and overlay images
+    PROF_HUD,         // Health, score, hearts and the profiler overlay itself
+    PROF_FLIP,        // SDL_Flip
+    PROF_COUNT
+} ProfPhase;
+
+/**
+ * @brief Per-frame counters, summed over a frame and reported as min/avg/max per frame.
+ */
+typedef enum {
+    PROF_SPRITES_DRAWN,   // Sprites that passed the visibility pass and were blitted
+    PROF_SPRITES_CULLED,  // Sprites rejected by the visibility pass
+    PROF_COUNTER_COUNT
+} ProfCounter;
+
+#if PROFILER_ENABLED
+
+/**
+ * @brief Starts a frame: clears the per-frame accumulators and the phase stack.
+ * @return Nothing.
+ */
+void profiler_frame_begin(void);
+
+/**
+ * @brief Ends a frame and records every phase into its histograms.
+ * @return Nothing.
+ */
+void profiler_frame_end(void);
+
+/**
+ * @brief Drops the current frame (e.g. it ran the blocking enigma or maze loop).
+ * @return Nothing.
+ */
+void profiler_discard_frame(void);
+
+/**
+ * @brief Starts timing a phase, pausing the enclosing one.
+ * @param phase The phase.
+ * @return Nothing.
+ */
+void profiler_begin(ProfPhase phase);
+
+/**
+ * @brief Stops timing the phase started last and resumes the enclosing one.
+ * @param phase The phase (must match the last profiler_begin).
+ * @return Nothing.
+ */
+void profiler_end(ProfPhase phase);
+
+/**
+ * @brief Adds to a counter of the current frame.
+ * @param counter The counter.
+ * @param n The amount to add.
+ * @return Nothing.
+ */
+void profiler_count(ProfCounter counter, Uint32 n);
+
+/**
+ * @brief Shows or hides the overlay.
+ * @return Nothing.
+ */
+void profiler_toggle_overlay(void);
+
+/**
+ * @brief Draws min/avg/p99 of every phase and min/avg/max of every counter
+ *        for the last window, if the overlay is on.
+ * @param screen The SDL surface to render on.
+ * @param x The x-coordinate of the table.
+ * @param y The y-coordinate of the table.
+ * @return Nothing.
+ */
+void profiler_draw_overlay(SDL_Surface *screen, int x, int y);
+
+/**
+ * @brief Writes the statistics of the whole run to <base>.csv and <base>.json.
+ * @param base Output path without extension.
+ * @return 0 on success, -1 if a file could not be written.
+ */
+int profiler_dump(const char *base);
+
+#define PROF_BEGIN(phase) profiler_begin(phase)
+#define PROF_END(phase) profiler_end(phase)
+#define PROF_ADD(counter, n) profiler_count(counter, n)
+
+#else
+
+#define profiler_frame_begin() ((void)0)
+#define profiler_frame_end() ((void)0)
+#define profiler_discard_frame() ((void)0)
+#define profiler_toggle_overlay() ((void)0)
+#define profiler_draw_overlay(screen, x, y) ((void)0)
+#define profiler_dump(base) ((void)(base), 0)
+#define PROF_BEGIN(phase) ((void)0)
+#define PROF_END(phase) ((void)0)
+#define PROF_ADD(counter, n) ((void)0)
+
+#endif // PROFILER_ENABLED
+
+#endif // PROFILER_H
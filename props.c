@@ -0,0 +1,385 @@
+/**
+ * @file props.c
+ * @brief Loading, motion, collision and drawing of the level props.
+ * @author MohamedNourMraad
+ * @date 2025-05-24
+ * @version 1.0
+ */
+
+#include <SDL/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <math.h>
+#include "props.h"
+#include "assets.h"
+#include "log.h"
+
+static const char *const kind_names[PROP_KIND_COUNT] = {
+    "decor", "pickup", "mummy", "closet", "relic", "treasure"
+};
+
+static const char *const sound_names[PROP_SOUND_COUNT] = {
+    "none", "poison", "health", "pts", "doom", "tresor"
+};
+
+/**
+ * @brief Looks a word up in a name table.
+ * @param names The table.
+ * @param count Number of entries.
+ * @param word The word to find.
+ * @return The index, or -1 if the word is unknown.
+ */
+static int find_name(const char *const *names, int count, const char *word) {
+    for (int i = 0; i < count; i++) {
+        if (strcmp(names[i], word) == 0) return i;
+    }
+    return -1;
+}
+
+/**
+ * @brief Parses a comma-separated flag list ("-" for none).
+ * @param list The flag list.
+ * @param flags Receives the PROP_* bits.
+ * @return 0 on success, -1 on an unknown flag.
+ */
+static int parse_flags(char *list, Uint8 *flags) {
+    *flags = 0;
+    if (strcmp(list, "-") == 0) return 0;
+    for (char *word = strtok(list, ","); word; word = strtok(NULL, ",")) {
+        if (strcmp(word, "bob") == 0) *flags |= PROP_BOB;
+        else if (strcmp(word, "sway") == 0) *flags |= PROP_SWAY;
+        else if (strcmp(word, "consume") == 0) *flags |= PROP_CONSUME;
+        else if (strcmp(word, "hidden") == 0) *flags |= PROP_HIDDEN;
+        else return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Registers one image in the next sprite slot, or reuses the slot that already names it.
+ *        The image itself is loaded with the level (props_load_level).
+ * @param s The prop store.
+ * @param file The image file.
+ * @param reuse 0 to always take a new slot (animation frames must be consecutive).
+ * @return The sprite index, or -1 on failure.
+ */
+static int load_sprite(PropStore *s, const char *file, int reuse) {
+    if (reuse) {
+        for (int i = 0; i < s->sprite_count; i++) {
+            if (strcmp(s->sprite_files[i], file) == 0) return i;
+        }
+    }
+    if (s->sprite_count >= PROP_SPRITE_MAX) {
+        LOG_ERROR("Too many prop images (max %d) while loading %s\n", PROP_SPRITE_MAX, file);
+        return -1;
+    }
+    int id = s->sprite_count;
+    snprintf(s->sprite_files[id], PROP_FILE_MAX, "%s", file);
+    s->sprite_count++;
+    return id;
+}
+
+/**
+ * @brief Registers the images of an animated prop. The image name holds one %d, replaced by 1..frames.
+ * @param s The prop store.
+ * @param pattern The image name pattern (e.g. "tresor%d.png").
+ * @param frames Number of images.
+ * @return The index of the first image, or -1 on failure.
+ */
+static int load_frames(PropStore *s, const char *pattern, int frames) {
+    const char *mark = strchr(pattern, '%');
+    if (mark == NULL || mark[1] != 'd' || strchr(mark + 1, '%') != NULL) {
+        LOG_ERROR("Animated prop image \"%s\" needs exactly one %%d\n", pattern);
+        return -1;
+    }
+    int first = -1;
+    for (int f = 0; f < frames; f++) {
+        char file[PROP_FILE_MAX];
+        snprintf(file, sizeof(file), "%.*s%d%s", (int)(mark - pattern), pattern, f + 1, mark + 2);
+        int id = load_sprite(s, file, 0);
+        if (id < 0) return -1;
+        if (first < 0) first = id;
+    }
+    return first;
+}
+
+/**
+ * @brief Maps a world x coordinate to its grid column (clamped to the grid).
+ * @param x World x coordinate.
+ * @return The column index.
+ */
+static int cell_of(int x) {
+    if (x < 0) return 0;
+    int c = x >> PROP_GRID_CELL_SHIFT;
+    return c < PROP_GRID_CELLS ? c : PROP_GRID_CELLS - 1;
+}
+
+/**
+ * @brief Files a prop under every column its box covers.
+ * @param s The prop store.
+ * @param i Index of the prop.
+ * @return Nothing.
+ */
+static void grid_insert(PropStore *s, int i) {
+    s->cell_lo[i] = cell_of(s->x[i]);
+    s->cell_hi[i] = cell_of(s->x[i] + s->w[i] - 1);
+    for (int c = s->cell_lo[i]; c <= s->cell_hi[i]; c++) {
+        s->cell_items[c][s->cell_count[c]++] = i;
+    }
+}
+
+/**
+ * @brief Takes a prop out of the columns it is filed in.
+ * @param s The prop store.
+ * @param i Index of the prop.
+ * @return Nothing.
+ */
+static void grid_remove(PropStore *s, int i) {
+    for (int c = s->cell_lo[i]; c <= s->cell_hi[i]; c++) {
+        for (int k = 0; k < s->cell_count[c]; k++) {
+            if (s->cell_items[c][k] == i) {
+                s->cell_items[c][k] = s->cell_items[c][--s->cell_count[c]];
+                break;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Refiles a prop after its x changed, if it now covers other columns.
+ * @param s The prop store.
+ * @param i Index of the prop.
+ * @return Nothing.
+ */
+static void grid_update(PropStore *s, int i) {
+    if (cell_of(s->x[i]) == s->cell_lo[i] && cell_of(s->x[i] + s->w[i] - 1) == s->cell_hi[i]) return;
+    grid_remove(s, i);
+    grid_insert(s, i);
+}
+
+int props_load(PropStore *s, const char *path) {
+    if (s == NULL) {
+        LOG_ERROR("Error: Null prop store in props_load\n");
+        return -1;
+    }
+    memset(s, 0, sizeof(*s));
+
+    FILE *fp = fopen(path, "r");
+    if (!fp) {
+        LOG_ERROR("Error opening %s: %s\n", path, strerror(errno));
+        return -1;
+    }
+
+    char line[256];
+    int line_no = 0;
+    while (fgets(line, sizeof(line), fp)) {
+        line_no++;
+        char *start = line + strspn(line, " \t");
+        if (*start == '#' || *start == '\n' || *start == '\0') continue;
+
+        int level, frames, x, y, w, h, health, points;
+        unsigned cooldown, spawn, respawn;
+        float amplitude;
+        char image[PROP_FILE_MAX], kind[16], sound[16], flags[64];
+        if (sscanf(start, "%d %63s %d %d %d %d %d %15s %d %d %15s %u %u %u %f %63s",
+                   &level, image, &frames, &x, &y, &w, &h, kind, &health, &points,
+                   sound, &cooldown, &spawn, &respawn, &amplitude, flags) != 16) {
+            LOG_ERROR("%s:%d: expected 16 fields\n", path, line_no);
+            fclose(fp);
+            return -1;
+        }
+        if (s->count >= PROP_MAX) {
+            LOG_ERROR("%s:%d: too many props (max %d)\n", path, line_no, PROP_MAX);
+            fclose(fp);
+            return -1;
+        }
+
+        int i = s->count;
+        int kind_id = find_name(kind_names, PROP_KIND_COUNT, kind);
+        int sound_id = find_name(sound_names, PROP_SOUND_COUNT, sound);
+        if (kind_id < 0 || sound_id < 0 || frames < 1 || w < 1 || h < 1 || parse_flags(flags, &s->flags[i]) < 0) {
+            LOG_ERROR("%s:%d: invalid kind, sound, size, frame count or flag\n", path, line_no);
+            fclose(fp);
+            return -1;
+        }
+        int sprite = (frames > 1) ? load_frames(s, image, frames) : load_sprite(s, image, 1);
+        if (sprite < 0) {
+            fclose(fp);
+            return -1;
+        }
+
+        s->x[i] = s->home_x[i] = x;
+        s->y[i] = s->home_y[i] = y;
+        s->w[i] = w;
+        s->h[i] = h;
+        s->amplitude[i] = amplitude;
+        s->sprite[i] = sprite;
+        s->frames[i] = frames;
+        s->kind[i] = kind_id;
+        s->level[i] = level;
+        s->sound[i] = sound_id;
+        s->visible[i] = !(s->flags[i] & PROP_HIDDEN);
+        s->health[i] = health;
+        s->points[i] = points;
+        s->cooldown[i] = cooldown;
+        s->spawn_at[i] = (s->flags[i] & PROP_HIDDEN) ? spawn : 0;
+        s->respawn[i] = respawn;
+        grid_insert(s, i);
+        s->count++;
+    }
+    fclose(fp);
+
+    LOG_INFO("Loaded %d props (%d images, loaded per level) from %s\n", s->count, s->sprite_count, path);
+    return 0;
+}
+
+int props_update(PropStore *s, int level, Uint32 t_now) {
+    int finished = 0;
+    double wave = sin(PROP_MOTION_FREQUENCY * t_now); // Same phase for every prop
+
+    for (int i = 0; i < s->count; i++) {
+        if (s->level[i] != level) continue;
+        if (!s->visible[i] && s->spawn_at[i] != 0 && t_now >= s->spawn_at[i]) {
+            s->visible[i] = 1;
+            s->spawn_at[i] = 0;
+            s->x[i] = s->home_x[i];
+            s->y[i] = s->home_y[i];
+            grid_update(s, i);
+            LOG_DEBUG("Prop %d (%s) appears\n", i, s->sprite_files[s->sprite[i]]);
+        }
+        if (s->flags[i] & PROP_BOB) s->y[i] = s->home_y[i] + s->amplitude[i] * wave;
+        if (s->flags[i] & PROP_SWAY) {
+            s->x[i] = s->home_x[i] + s->amplitude[i] * wave;
+            grid_update(s, i);
+        }
+        if (s->anim_start[i] != 0) {
+            Uint32 elapsed = t_now - s->anim_start[i];
+            if (elapsed >= PROP_ANIM_MS) {
+                s->anim_start[i] = 0;
+                s->frame[i] = 0;
+                finished++;
+            } else {
+                s->frame[i] = (elapsed / PROP_ANIM_FRAME_MS) % s->frames[i];
+            }
+        }
+    }
+    return finished;
+}
+
+int props_collide(const PropStore *s, int level, const SDL_Rect *box, Uint32 t_now, int *hits, int max_hits) {
+    int n = 0;
+    int left = box->x, right = box->x + box->w;
+    int top = box->y, bottom = box->y + box->h;
+    int first = cell_of(left), last = cell_of(right - 1);
+
+    for (int c = first; c <= last; c++) {
+        for (int k = 0; k < s->cell_count[c] && n < max_hits; k++) {
+            int i = s->cell_items[c][k];
+            if (c != (s->cell_lo[i] > first ? s->cell_lo[i] : first)) continue; // Already seen in an earlier column
+            int overlap = (left < s->x[i] + s->w[i]) & (right > s->x[i]) &
+                          (top < s->y[i] + s->h[i]) & (bottom > s->y[i]);
+            int live = s->visible[i] & (s->level[i] == level) & (s->kind[i] != PROP_DECOR) &
+                       (t_now - s->last_hit[i] >= s->cooldown[i]);
+            if (overlap & live) hits[n++] = i;
+        }
+    }
+
+    // Columns are unordered: report hits in description order, like a linear scan would
+    for (int a = 1; a < n; a++) {
+        int v = hits[a], b = a;
+        for (; b > 0 && hits[b - 1] > v; b--) hits[b] = hits[b - 1];
+        hits[b] = v;
+    }
+    return n;
+}
+
+void props_hit(PropStore *s, int i, Uint32 t_now) {
+    s->last_hit[i] = t_now;
+    if (s->frames[i] > 1) {
+        s->anim_start[i] = t_now ? t_now : 1; // 0 means "no animation"
+        s->frame[i] = 0;
+    }
+    if (s->flags[i] & PROP_CONSUME) {
+        s->visible[i] = 0;
+        s->spawn_at[i] = s->respawn[i] ? t_now + s->respawn[i] : 0;
+    }
+}
+
+void props_draw(const PropStore *s, RenderCtx *ctx, int level) {
+    for (int i = 0; i < s->count; i++) {
+        if (!s->visible[i] || s->level[i] != level) continue;
+        const AssetSprite *sprite = &s->sprites[s->sprite[i] + s->frame[i]];
+        SDL_Rect pos = {s->x[i], s->y[i], 0, 0};
+        draw_sprite_world(ctx, *sprite->source, &sprite->rect, &pos);
+    }
+}
+
+const AssetSprite *props_sprite(const PropStore *s, const char *file) {
+    for (int i = 0; i < s->sprite_count; i++) {
+        if (strcmp(s->sprite_files[i], file) == 0) return &s->sprites[i];
+    }
+    return NULL;
+}
+
+/**
+ * @brief Marks the images used by the props of one level.
+ * @param s The prop store (read only).
+ * @param level The level.
+ * @param used Receives 1 for each sprite index a prop of the level shows.
+ * @return Nothing.
+ */
+static void mark_level_sprites(const PropStore *s, int level, Uint8 *used) {
+    memset(used, 0, PROP_SPRITE_MAX);
+    for (int i = 0; i < s->count; i++) {
+        if (s->level[i] != level) continue;
+        for (int f = 0; f < s->frames[i]; f++) {
+            used[s->sprite[i] + f] = 1;
+        }
+    }
+}
+
+int props_load_level(PropStore *s, int level) {
+    Uint8 used[PROP_SPRITE_MAX];
+    int loaded = 0;
+
+    mark_level_sprites(s, level, used);
+    for (int id = 0; id < s->sprite_count; id++) {
+        if (!used[id] || s->sprites[id].source != NULL) continue;
+        if (!asset_load_sprite(&s->sprites[id], s->sprite_files[id])) {
+            LOG_ERROR("Failed to load prop image %s: %s\n", s->sprite_files[id], IMG_GetError());
+            return -1;
+        }
+        loaded++;
+    }
+    LOG_INFO("Loaded %d prop images for level %d\n", loaded, level);
+    return 0;
+}
+
+void props_free_level(PropStore *s, int level) {
+    Uint8 used[PROP_SPRITE_MAX], kept[PROP_SPRITE_MAX] = {0};
+
+    // Images shown on another level too stay resident
+    for (int i = 0; i < s->count; i++) {
+        if (s->level[i] == level) continue;
+        for (int f = 0; f < s->frames[i]; f++) {
+            kept[s->sprite[i] + f] = 1;
+        }
+    }
+    mark_level_sprites(s, level, used);
+    for (int id = 0; id < s->sprite_count; id++) {
+        if (used[id] && !kept[id]) {
+            asset_free_sprite(&s->sprites[id]);
+        }
+    }
+}
+
+void props_free(PropStore *s) {
+    if (s == NULL) return;
+    for (int i = 0; i < s->sprite_count; i++) {
+        asset_free_sprite(&s->sprites[i]);
+    }
+    s->sprite_count = 0;
+    s->count = 0;
+}
@@ -0,0 +1,178 @@
+/**
+ * @file props.h
+ * @brief Level props (potions, treasure, relic, decor) kept as parallel arrays and
+ *        loaded from a level description file, so adding a prop is a data change.
+ * @author MohamedNourMraad
+ * @date 2025-05-24
+ * @version 1.0
+ */
+
+#ifndef PROPS_H
+#define PROPS_H
+
+#include <SDL/SDL.h>
+#include "render.h"
+#include "assets.h"
+
+#define PROPS_FILE "props.txt"        // Level description read at startup
+#define PROP_MAX 64                   // Props of all levels together
+#define PROP_SPRITE_MAX 32            // Distinct images (each animation frame counts)
+#define PROP_FILE_MAX 64              // Longest image file name
+#define PROP_MOTION_FREQUENCY 0.005f  // Bob and sway speed (radians per ms)
+#define PROP_ANIM_FRAME_MS 250        // Time each frame of an animated prop stays on screen
+#define PROP_ANIM_MS 1000             // Length of the animation started by a hit
+#define PROP_GRID_CELL_SHIFT 8        // Broad-phase cells are 256 px wide columns
+#define PROP_GRID_CELLS 32            // Covers 8192 px; props further right share the last cell
+
+#define PROP_BOB 0x01      // y oscillates around the spawn position
+#define PROP_SWAY 0x02     // x oscillates around the spawn position
+#define PROP_CONSUME 0x04  // Disappears when touched (and comes back after its respawn delay)
+#define PROP_HIDDEN 0x08   // Invisible until its spawn time
+
+/**
+ * @brief What a prop does when a player touches it. Health, points and sound come
+ *        from the description; the kinds below only add what cannot be expressed as data.
+ */
+typedef enum {
+    PROP_DECOR,     // Drawn only, never collides
+    PROP_PICKUP,    // Health, points and sound only
+    PROP_MUMMY,     // Gives the key once the enigma is solved
+    PROP_CLOSET,    // Shows romlet.png
+    PROP_RELIC,     // Second relic of the win condition
+    PROP_TREASURE,  // Points only on the first hit of the level
+    PROP_KIND_COUNT
+} PropKind;
+
+/**
+ * @brief Sound played when a prop is hit (main.c owns the chunks).
+ */
+typedef enum {
+    PROP_SOUND_NONE,
+    PROP_SOUND_POISON,
+    PROP_SOUND_HEALTH,
+    PROP_SOUND_PTS,
+    PROP_SOUND_DOOM,
+    PROP_SOUND_TRESOR,
+    PROP_SOUND_COUNT
+} PropSound;
+
+/**
+ * @brief Every prop of the game, one array per field so the per-frame passes
+ *        (collision, motion, drawing) walk contiguous memory. A uniform grid of
+ *        x columns files each prop under the columns its box covers, so collision
+ *        queries only look at the props near the player.
+ */
+typedef struct {
+    int count;
+    int x[PROP_MAX], y[PROP_MAX];            // Current world position
+    int w[PROP_MAX], h[PROP_MAX];            // Hit box size
+    int home_x[PROP_MAX], home_y[PROP_MAX];  // Spawn position, centre of the bob/sway
+    float amplitude[PROP_MAX];               // Bob/sway amplitude in pixels
+    Uint8 sprite[PROP_MAX];                  // First image in sprites[]
+    Uint8 frames[PROP_MAX];                  // Number of consecutive images (1: static)
+    Uint8 frame[PROP_MAX];                   // Image currently shown
+    Uint8 kind[PROP_MAX];                    // PropKind
+    Uint8 level[PROP_MAX];                   // Level the prop lives on
+    Uint8 flags[PROP_MAX];                   // PROP_BOB, PROP_SWAY, PROP_CONSUME, PROP_HIDDEN
+    Uint8 sound[PROP_MAX];                   // PropSound
+    Uint8 visible[PROP_MAX];
+    Sint16 health[PROP_MAX], points[PROP_MAX];
+    Uint32 cooldown[PROP_MAX];               // Minimum time between two hits (ms)
+    Uint32 last_hit[PROP_MAX];
+    Uint32 spawn_at[PROP_MAX];               // Time a hidden prop appears (0: stays hidden)
+    Uint32 respawn[PROP_MAX];                // Delay before a consumed prop comes back (0: never)
+    Uint32 anim_start[PROP_MAX];             // Start of the running animation (0: none)
+    Uint8 cell_lo[PROP_MAX], cell_hi[PROP_MAX];        // Grid columns the prop is filed in
+    Uint8 cell_count[PROP_GRID_CELLS];                 // Props filed in each column
+    Uint8 cell_items[PROP_GRID_CELLS][PROP_MAX];       // Prop indices of each column (unordered)
+    int sprite_count;
+    AssetSprite sprites[PROP_SPRITE_MAX];    // Frames may share one atlas page; empty while their level is not loaded
+    char sprite_files[PROP_SPRITE_MAX][PROP_FILE_MAX];
+} PropStore;
+
+/**
+ * @brief Reads the level description and registers the images it names; they are
+ *        loaded level by level with props_load_level. Each non-comment line is one prop:
+ *        level image frames x y w h kind health points sound cooldown spawn respawn amplitude flags
+ * @param s The store to fill (must stay at the same address until props_free).
+ * @param path The description file.
+ * @return 0 on success, -1 on failure.
+ */
+int props_load(PropStore *s, const char *path);
+
+/**
+ * @brief Loads the images of the props of one level (images already loaded are kept).
+ * @param s The prop store.
+ * @param level The level.
+ * @return 0 on success, -1 on failure.
+ */
+int props_load_level(PropStore *s, int level);
+
+/**
+ * @brief Releases the images only the props of one level show. The props stay in the
+ *        store; the level must not be drawn until props_load_level loads them again.
+ * @param s The prop store.
+ * @param level The level.
+ * @return Nothing.
+ */
+void props_free_level(PropStore *s, int level);
+
+/**
+ * @brief Spawns due props and advances the bob/sway motion and the animations of one level.
+ *        Props whose x motion takes them into other grid columns are refiled.
+ * @param s The prop store.
+ * @param level The current level.
+ * @param t_now Current time in ms.
+ * @return The number of animations that ended during this update.
+ */
+int props_update(PropStore *s, int level, Uint32 t_now);
+
+/**
+ * @brief Lists the visible props of a level that overlap a box and are off cooldown.
+ *        Only the props filed in the grid columns covered by the box are tested.
+ * @param s The prop store (read only).
+ * @param level The current level.
+ * @param box The hit box in world coordinates.
+ * @param t_now Current time in ms.
+ * @param hits Receives the prop indices, in description order.
+ * @param max_hits Capacity of hits.
+ * @return The number of indices written.
+ */
+int props_collide(const PropStore *s, int level, const SDL_Rect *box, Uint32 t_now, int *hits, int max_hits);
+
+/**
+ * @brief Records a hit: restarts the cooldown, starts the animation and
+ *        hides a consumable prop until its respawn time.
+ * @param s The prop store.
+ * @param i Index of the prop.
+ * @param t_now Current time in ms.
+ * @return Nothing.
+ */
+void props_hit(PropStore *s, int i, Uint32 t_now);
+
+/**
+ * @brief Queues the visible props of a level in description order (off-screen ones are culled).
+ * @param s The prop store (read only).
+ * @param ctx Render context (screen, camera and draw list).
+ * @param level The current level.
+ * @return Nothing.
+ */
+void props_draw(const PropStore *s, RenderCtx *ctx, int level);
+
+/**
+ * @brief Finds the image of a prop, so HUD code can reuse it. The sprite is empty
+ *        (source NULL) while the level of the prop is not loaded.
+ * @param s The prop store (read only).
+ * @param file The image file name.
+ * @return The sprite (owned by the store), or NULL if no prop uses that image.
+ */
+const AssetSprite *props_sprite(const PropStore *s, const char *file);
+
+/**
+ * @brief Frees the images of the store and empties it.
+ * @param s The prop store.
+ * @return Nothing.
+ */
+void props_free(PropStore *s);
+
+#endif // PROPS_H
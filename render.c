@@ -0,0 +1,85 @@
+/**
+ * @file render.c
+ * @brief Camera transform, visibility pass and draw list for sprites.
+ * @author MohamedNourMraad
+ * @date 2025-05-24
+ * @version 1.0
+ */
+
+#include <SDL/SDL.h>
+#include "render.h"
+#include "dirty.h"
+
+void render_begin(RenderCtx *ctx, SDL_Surface *screen, const SDL_Rect *camera) {
+    ctx->screen = screen;
+    ctx->camera.x = camera->x;
+    ctx->camera.y = camera->y;
+    ctx->camera.w = screen ? screen->w : 0;
+    ctx->camera.h = screen ? screen->h : 0;
+    ctx->count = 0;
+    ctx->drawn = 0;
+    ctx->culled = 0;
+}
+
+/**
+ * @brief Tests a sprite against the screen and queues it if any part is visible.
+ * @param ctx The render context.
+ * @param surface The image to draw (may be NULL).
+ * @param src The part of the image to draw, or NULL for all of it.
+ * @param x Screen x coordinate.
+ * @param y Screen y coordinate.
+ * @return 1 if the sprite was queued, 0 if it was culled.
+ */
+static int queue_sprite(RenderCtx *ctx, SDL_Surface *surface, const SDL_Rect *src, int x, int y) {
+    if (surface == NULL || ctx->screen == NULL) return 0;
+
+    int w = src ? src->w : surface->w;
+    int h = src ? src->h : surface->h;
+    if (x >= ctx->camera.w || y >= ctx->camera.h || x + w <= 0 || y + h <= 0) {
+        ctx->culled++; // Entirely off screen: not worth a blit call
+        return 0;
+    }
+
+    if (ctx->count == RENDER_LIST_MAX) {
+        render_flush(ctx);
+    }
+    DrawItem *item = &ctx->items[ctx->count++];
+    item->surface = surface;
+    if (src) {
+        item->src = *src;
+    } else {
+        item->src.x = 0;
+        item->src.y = 0;
+        item->src.w = surface->w;
+        item->src.h = surface->h;
+    }
+    item->x = x;
+    item->y = y;
+    return 1;
+}
+
+int draw_sprite_world(RenderCtx *ctx, SDL_Surface *surface, const SDL_Rect *src, const SDL_Rect *world_rect) {
+    return queue_sprite(ctx, surface, src, world_rect->x - ctx->camera.x, world_rect->y - ctx->camera.y);
+}
+
+int draw_sprite_screen(RenderCtx *ctx, SDL_Surface *surface, const SDL_Rect *src, int x, int y) {
+    return queue_sprite(ctx, surface, src, x, y);
+}
+
+void render_flush(RenderCtx *ctx) {
+    for (int i = 0; i < ctx->count; i++) {
+        DrawItem *item = &ctx->items[i];
+        SDL_Rect dst = {item->x, item->y, 0, 0}; // SDL writes the clipped rects back
+        dirty_blit(item->surface, &item->src, ctx->screen, &dst);
+    }
+    ctx->drawn += ctx->count;
+    ctx->count = 0;
+}
+
+int render_screen_x(const RenderCtx *ctx, int world_x) {
+    return world_x - ctx->camera.x;
+}
+
+int render_screen_y(const RenderCtx *ctx, int world_y) {
+    return world_y - ctx->camera.y;
+}
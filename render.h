@@ -0,0 +1,94 @@
+/**
+ * @file render.h
+ * @brief World-space drawing: a visibility pass tests each sprite against the camera
+ *        and queues only the visible ones in a draw list, which is then blitted in order.
+ * @author MohamedNourMraad
+ * @date 2025-05-24
+ * @version 1.0
+ */
+
+#ifndef RENDER_H
+#define RENDER_H
+
+#include <SDL/SDL.h>
+
+#define RENDER_LIST_MAX 128  // Queued sprites; a full list is flushed early, order is kept
+
+/**
+ * @brief One visible sprite waiting to be blitted.
+ */
+typedef struct {
+    SDL_Surface *surface;
+    SDL_Rect src;  // Part of the image to draw
+    Sint16 x, y;   // Screen position
+} DrawItem;
+
+/**
+ * @brief What a frame draws into, which part of the world it shows and the
+ *        sprites that passed the visibility test but are not blitted yet.
+ */
+typedef struct {
+    SDL_Surface *screen;
+    SDL_Rect camera;  // World rect shown on screen (w/h are the screen size)
+    DrawItem items[RENDER_LIST_MAX];
+    int count;        // Queued items
+    int drawn;        // Sprites blitted since render_begin
+    int culled;       // Sprites rejected since render_begin
+} RenderCtx;
+
+/**
+ * @brief Prepares a render context for the current frame (empty list, counters at 0).
+ * @param ctx The context to fill.
+ * @param screen The screen surface.
+ * @param camera The camera position in world coordinates (only x and y are used).
+ * @return Nothing.
+ */
+void render_begin(RenderCtx *ctx, SDL_Surface *screen, const SDL_Rect *camera);
+
+/**
+ * @brief Queues a sprite given in world coordinates if it overlaps the viewport.
+ *        World positions are never modified.
+ * @param ctx The render context.
+ * @param surface The image to draw (may be NULL).
+ * @param src The part of the image to draw, or NULL for all of it.
+ * @param world_rect Position of the sprite in the world (only x and y are used).
+ * @return 1 if the sprite was queued, 0 if it was culled.
+ */
+int draw_sprite_world(RenderCtx *ctx, SDL_Surface *surface, const SDL_Rect *src, const SDL_Rect *world_rect);
+
+/**
+ * @brief Queues a sprite given in screen coordinates (overlays) if it overlaps the screen.
+ * @param ctx The render context.
+ * @param surface The image to draw (may be NULL).
+ * @param src Part of the surface to draw (atlas rect), or NULL for all of it.
+ * @param x Screen x coordinate.
+ * @param y Screen y coordinate.
+ * @return 1 if the sprite was queued, 0 if it was culled.
+ */
+int draw_sprite_screen(RenderCtx *ctx, SDL_Surface *surface, const SDL_Rect *src, int x, int y);
+
+/**
+ * @brief Blits the queued sprites in the order they were queued and empties the list.
+ *        Call it before drawing anything directly on the screen that must stay on top.
+ * @param ctx The render context.
+ * @return Nothing.
+ */
+void render_flush(RenderCtx *ctx);
+
+/**
+ * @brief Converts a world x coordinate to a screen x coordinate.
+ * @param ctx The render context (read only).
+ * @param world_x World x coordinate.
+ * @return Screen x coordinate.
+ */
+int render_screen_x(const RenderCtx *ctx, int world_x);
+
+/**
+ * @brief Converts a world y coordinate to a screen y coordinate.
+ * @param ctx The render context (read only).
+ * @param world_y World y coordinate.
+ * @return Screen y coordinate.
+ */
+int render_screen_y(const RenderCtx *ctx, int world_y);
+
+#endif // RENDER_H
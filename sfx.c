@@ -0,0 +1,240 @@
+/**
+ * @file sfx.c
+ * @brief Sound effects: a bank of chunks converted to the mixer format at load time,
+ *        triggered through a per-frame queue and played on a fixed budget of voices
+ *        with priorities, voice stealing and per-sound rate limits.
+ * @author MohamedNourMraad
+ * @date 2025-06-03
+ * @version 1.0
+ */
+
+#include <SDL/SDL.h>
+#include <SDL/SDL_mixer.h>
+#include <stdio.h>
+#include "sfx.h"
+#include "assets.h"
+#include "log.h"
+
+/**
+ * @brief What the game knows about one effect.
+ */
+typedef struct {
+    const char *file;
+    int priority;          // Higher wins when voices run out
+    Uint32 min_interval;   // Triggers closer than this to the last start are dropped (ms)
+    int resident;          // Loaded by sfx_load_bank; the others are loaded on demand
+} SfxInfo;
+
+static const SfxInfo bank[SFX_COUNT] = {
+    [SFX_BOSS]    = {"boss.wav",    4,    0, 1},
+    [SFX_DOOR]    = {"door.wav",    3,    0, 1},
+    [SFX_DOOR2]   = {"door2.wav",   3,    0, 0},  // Level 2 only
+    [SFX_FIGHT]   = {"fight.wav",   2,    0, 1},
+    [SFX_HEALTH]  = {"health.wav",  1,  250, 1},
+    [SFX_POISON]  = {"poison.wav",  1,  250, 1},
+    [SFX_PTS]     = {"pts.wav",     1,  100, 1},
+    [SFX_TRESOR]  = {"tresor.wav",  3,  500, 1},
+    [SFX_DOOM]    = {"doom.wav",    3,  500, 1},
+    [SFX_CLICK]   = {"clic.wav",    2,   50, 1},
+    [SFX_CORRECT] = {"correct.wav", 4,    0, 1},
+    [SFX_WRONG]   = {"wrong.wav",   4,    0, 1},
+};
+
+/**
+ * @brief What one mixer channel is playing.
+ */
+typedef struct {
+    SfxId id;              // SFX_NONE: free
+    int loop;
+    Uint32 started;
+} Voice;
+
+/**
+ * @brief One trigger waiting for sfx_dispatch.
+ */
+typedef struct {
+    SfxId id;
+    int loop;
+} Trigger;
+
+static Mix_Chunk *chunks[SFX_COUNT];
+static Uint32 last_started[SFX_COUNT];
+static Voice voices[SFX_VOICES];
+static Trigger queue[SFX_QUEUE_MAX];
+static int queue_count = 0;
+
+// Statistics, logged by sfx_close
+static Uint32 played = 0, stolen = 0, limited = 0, starved = 0;
+
+int sfx_open(void) {
+    if (Mix_OpenAudio(SFX_RATE, MIX_DEFAULT_FORMAT, 2, SFX_BUFFER) < 0) {
+        return -1;
+    }
+    Mix_AllocateChannels(SFX_VOICES);
+    for (int i = 0; i < SFX_VOICES; i++) {
+        voices[i].id = SFX_NONE;
+    }
+    return 0;
+}
+
+int sfx_load(SfxId id) {
+    if (chunks[id]) {
+        return 0;
+    }
+    chunks[id] = Mix_LoadWAV_RW(asset_open_rw(bank[id].file), 1); // Converted to the mixer format here
+    if (chunks[id] == NULL) {
+        LOG_ERROR("Erreur de chargement de %s: %s\n", bank[id].file, Mix_GetError());
+        return -1;
+    }
+    return 0;
+}
+
+int sfx_load_bank(void) {
+    int status = 0;
+    for (int id = 0; id < SFX_COUNT; id++) {
+        if (bank[id].resident && sfx_load(id) < 0) {
+            status = -1;
+        }
+    }
+    return status;
+}
+
+void sfx_stop(SfxId id) {
+    for (int i = 0; i < SFX_VOICES; i++) {
+        if (voices[i].id == id) {
+            Mix_HaltChannel(i);
+            voices[i].id = SFX_NONE;
+        }
+    }
+    for (int i = 0; i < queue_count; i++) {
+        if (queue[i].id == id) {
+            queue[i--] = queue[--queue_count];
+        }
+    }
+}
+
+void sfx_unload(SfxId id) {
+    sfx_stop(id);
+    if (chunks[id]) {
+        Mix_FreeChunk(chunks[id]);
+        chunks[id] = NULL;
+    }
+}
+
+/**
+ * @brief Adds a trigger to the queue. When it is full, the least important trigger
+ *        is dropped if it ranks below the new one.
+ * @param id The effect.
+ * @param loop 1 to repeat until sfx_stop.
+ * @return Nothing.
+ */
+static void enqueue(SfxId id, int loop) {
+    if (id <= SFX_NONE || id >= SFX_COUNT || chunks[id] == NULL) {
+        return;
+    }
+    int weakest = -1;
+    for (int i = 0; i < queue_count; i++) {
+        if (queue[i].id == id) {
+            queue[i].loop |= loop; // Same effect twice in one frame plays once
+            return;
+        }
+        if (weakest < 0 || bank[queue[i].id].priority < bank[queue[weakest].id].priority) {
+            weakest = i;
+        }
+    }
+    if (queue_count == SFX_QUEUE_MAX) {
+        starved++; // One of the two is lost
+        if (bank[queue[weakest].id].priority >= bank[id].priority) {
+            return;
+        }
+        queue[weakest] = queue[--queue_count];
+    }
+    queue[queue_count].id = id;
+    queue[queue_count].loop = loop;
+    queue_count++;
+}
+
+void sfx_play(SfxId id) {
+    enqueue(id, 0);
+}
+
+void sfx_loop(SfxId id) {
+    for (int i = 0; i < SFX_VOICES; i++) {
+        if (voices[i].id == id && voices[i].loop && Mix_Playing(i)) {
+            return;
+        }
+    }
+    enqueue(id, 1);
+}
+
+/**
+ * @brief Picks the voice for a new effect: a free one, or the least important
+ *        (then oldest) one if it ranks strictly below the effect.
+ * @param priority Priority of the new effect.
+ * @return The channel, or -1 if every voice is more important.
+ */
+static int pick_voice(int priority) {
+    int victim = -1;
+    for (int i = 0; i < SFX_VOICES; i++) {
+        if (voices[i].id == SFX_NONE || !Mix_Playing(i)) {
+            voices[i].id = SFX_NONE; // Finished since the last dispatch
+            return i;
+        }
+        int p = bank[voices[i].id].priority;
+        if (p < priority && (victim < 0 || p < bank[voices[victim].id].priority ||
+                             (p == bank[voices[victim].id].priority && voices[i].started < voices[victim].started))) {
+            victim = i;
+        }
+    }
+    if (victim >= 0) {
+        Mix_HaltChannel(victim);
+        stolen++;
+        LOG_DEBUG("Voix %d (%s) volée\n", victim, bank[voices[victim].id].file);
+    }
+    return victim;
+}
+
+void sfx_dispatch(Uint32 t_now) {
+    while (queue_count > 0) {
+        int best = 0;
+        for (int i = 1; i < queue_count; i++) {
+            if (bank[queue[i].id].priority > bank[queue[best].id].priority) best = i;
+        }
+        Trigger t = queue[best];
+        queue[best] = queue[--queue_count];
+
+        const SfxInfo *info = &bank[t.id];
+        if (last_started[t.id] && t_now - last_started[t.id] < info->min_interval) {
+            limited++; // A burst of pickups plays the sound once
+            continue;
+        }
+        int channel = pick_voice(info->priority);
+        if (channel < 0) {
+            starved++;
+            continue;
+        }
+        if (Mix_PlayChannel(channel, chunks[t.id], t.loop ? -1 : 0) < 0) {
+            LOG_ERROR("Lecture de %s impossible: %s\n", info->file, Mix_GetError());
+            voices[channel].id = SFX_NONE;
+            continue;
+        }
+        voices[channel].id = t.id;
+        voices[channel].loop = t.loop;
+        voices[channel].started = t_now;
+        last_started[t.id] = t_now;
+        played++;
+    }
+}
+
+void sfx_close(void) {
+    Mix_HaltChannel(-1);
+    queue_count = 0;
+    for (int id = 0; id < SFX_COUNT; id++) {
+        if (chunks[id]) {
+            Mix_FreeChunk(chunks[id]);
+            chunks[id] = NULL;
+        }
+    }
+    LOG_INFO("Effets : %u joués, %u voix volées, %u limités, %u sans voix\n", played, stolen, limited, starved);
+    Mix_CloseAudio();
+}
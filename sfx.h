@@ -0,0 +1,105 @@
+/**
+ * @file sfx.h
+ * @brief Sound effects: a bank of chunks converted to the mixer format at load time,
+ *        triggered through a per-frame queue and played on a fixed budget of voices
+ *        with priorities, voice stealing and per-sound rate limits.
+ * @author MohamedNourMraad
+ * @date 2025-06-03
+ * @version 1.0
+ */
+
+#ifndef SFX_H
+#define SFX_H
+
+#include <SDL/SDL.h>
+
+#define SFX_RATE 44100     // Output sample rate
+#define SFX_BUFFER 512     // Samples per mixer callback: about 12 ms of latency at 44.1 kHz
+#define SFX_VOICES 8       // Mixer channels shared by all effects
+#define SFX_QUEUE_MAX 16   // Triggers kept between two dispatches
+
+/**
+ * @brief Every effect of the game. The bank in sfx.c gives each one its file,
+ *        priority and minimum time between two triggers.
+ */
+typedef enum {
+    SFX_NONE = -1,
+    SFX_BOSS,
+    SFX_DOOR,
+    SFX_DOOR2,
+    SFX_FIGHT,
+    SFX_HEALTH,
+    SFX_POISON,
+    SFX_PTS,
+    SFX_TRESOR,
+    SFX_DOOM,
+    SFX_CLICK,
+    SFX_CORRECT,
+    SFX_WRONG,
+    SFX_COUNT
+} SfxId;
+
+/**
+ * @brief Opens the mixer with a small buffer and allocates the voices.
+ * @return 0 on success, -1 on failure (see Mix_GetError).
+ */
+int sfx_open(void);
+
+/**
+ * @brief Loads every effect of the bank marked as resident. Call after asset_open_archive.
+ * @return 0 on success, -1 if one of them is missing.
+ */
+int sfx_load_bank(void);
+
+/**
+ * @brief Loads one effect (no-op if it is already loaded).
+ * @param id The effect.
+ * @return 0 on success, -1 on failure.
+ */
+int sfx_load(SfxId id);
+
+/**
+ * @brief Stops and frees one effect; triggering it afterwards does nothing.
+ * @param id The effect.
+ * @return Nothing.
+ */
+void sfx_unload(SfxId id);
+
+/**
+ * @brief Queues an effect for the next sfx_dispatch. Several triggers of the same
+ *        effect in one frame play it once.
+ * @param id The effect (SFX_NONE is ignored).
+ * @return Nothing.
+ */
+void sfx_play(SfxId id);
+
+/**
+ * @brief Queues an effect that repeats until sfx_stop. Does nothing if it is already looping.
+ * @param id The effect.
+ * @return Nothing.
+ */
+void sfx_loop(SfxId id);
+
+/**
+ * @brief Stops every voice playing an effect and drops its pending triggers.
+ * @param id The effect.
+ * @return Nothing.
+ */
+void sfx_stop(SfxId id);
+
+/**
+ * @brief Plays the queued effects, most important first. When all voices are busy,
+ *        the least important voice is stolen if it ranks below the new effect.
+ *        Call once per frame, and before any blocking screen.
+ * @param t_now Current time in ms.
+ * @return Nothing.
+ */
+void sfx_dispatch(Uint32 t_now);
+
+/**
+ * @brief Stops all effects, frees the bank, logs the voice statistics and closes the mixer.
+ * @return Nothing.
+ */
+void sfx_close(void);
+
+#endif // SFX_H
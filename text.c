@@ -0,0 +1,254 @@
+/**
+ * @file text.c
+ * @brief Cached text rendering: strings are rasterized once per (font, string, color)
+ *        and numbers are composed from a pre-rendered digit atlas.
+ * @author MohamedNourMraad
+ * @date 2025-05-21
+ * @version 1.0
+ */
+
+#include <SDL/SDL.h>
+#include <SDL/SDL_ttf.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "text.h"
+#include "dirty.h"
+#include "log.h"
+
+#define ATLAS_GLYPHS "0123456789-"
+#define ATLAS_GLYPH_COUNT 11
+
+/**
+ * @brief One rendered string.
+ */
+typedef struct {
+    TTF_Font *font;
+    SDL_Color color;
+    char *text;
+    SDL_Surface *surface;
+    Uint32 last_used;
+} TextEntry;
+
+/**
+ * @brief Digits and minus sign of one (font, color), packed side by side in one surface.
+ */
+typedef struct {
+    TTF_Font *font;
+    SDL_Color color;
+    SDL_Surface *surface;
+    SDL_Rect glyphs[ATLAS_GLYPH_COUNT];
+    Uint32 last_used;
+} DigitAtlas;
+
+static TextEntry cache[TEXT_CACHE_SIZE];
+static DigitAtlas atlases[TEXT_ATLAS_SIZE];
+static Uint32 use_counter = 0;
+
+/**
+ * @brief Compares two colors, ignoring the unused field.
+ * @param a First color.
+ * @param b Second color.
+ * @return 1 if equal, 0 otherwise.
+ */
+static int same_color(SDL_Color a, SDL_Color b) {
+    return a.r == b.r && a.g == b.g && a.b == b.b;
+}
+
+/**
+ * @brief Converts a colorkeyed text surface to the screen format with RLE.
+ * @param s The surface returned by SDL_ttf (freed on success).
+ * @return The converted surface, or s itself if no conversion was possible.
+ */
+static SDL_Surface *to_display_format(SDL_Surface *s) {
+    if (SDL_GetVideoSurface() == NULL) {
+        return s;
+    }
+    SDL_Surface *conv = SDL_DisplayFormat(s); // The colorkey travels with the conversion
+    if (conv == NULL) {
+        return s;
+    }
+    SDL_SetColorKey(conv, SDL_SRCCOLORKEY | SDL_RLEACCEL, conv->format->colorkey);
+    SDL_FreeSurface(s);
+    return conv;
+}
+
+SDL_Surface *text_render_cached(TTF_Font *font, const char *text, SDL_Color color) {
+    int victim = 0;
+
+    for (int i = 0; i < TEXT_CACHE_SIZE; i++) {
+        TextEntry *entry = &cache[i];
+        if (entry->surface && entry->font == font && same_color(entry->color, color) &&
+            strcmp(entry->text, text) == 0) {
+            entry->last_used = ++use_counter;
+            return entry->surface;
+        }
+        if (cache[victim].surface && (!entry->surface || entry->last_used < cache[victim].last_used)) {
+            victim = i; // Empty slot, or least recently used so far
+        }
+    }
+
+    SDL_Surface *rendered = TTF_RenderText_Solid(font, text, color);
+    if (rendered == NULL) {
+        LOG_ERROR("Unable to render text \"%s\": %s\n", text, TTF_GetError());
+        return NULL;
+    }
+
+    TextEntry *entry = &cache[victim];
+    if (entry->surface) {
+        SDL_FreeSurface(entry->surface);
+        free(entry->text);
+    }
+    entry->font = font;
+    entry->color = color;
+    entry->text = strdup(text);
+    entry->surface = to_display_format(rendered);
+    entry->last_used = ++use_counter;
+    if (entry->text == NULL) {
+        SDL_FreeSurface(entry->surface);
+        entry->surface = NULL;
+        return NULL;
+    }
+    return entry->surface;
+}
+
+int text_draw(SDL_Surface *screen, TTF_Font *font, const char *text, SDL_Color color, int x, int y) {
+    SDL_Surface *surface = text_render_cached(font, text, color);
+    if (surface == NULL) {
+        return 0;
+    }
+    SDL_Rect pos = {x, y, 0, 0};
+    dirty_blit(surface, NULL, screen, &pos);
+    return surface->w;
+}
+
+/**
+ * @brief Renders the digit glyphs of a font and color into one colorkeyed surface.
+ * @param atlas The atlas entry to fill (font and color already set).
+ * @return 0 on success, -1 on failure.
+ */
+static int build_atlas(DigitAtlas *atlas) {
+    SDL_Surface *glyphs[ATLAS_GLYPH_COUNT];
+    int total_w = 0, max_h = 0;
+
+    for (int i = 0; i < ATLAS_GLYPH_COUNT; i++) {
+        char glyph_text[2] = {ATLAS_GLYPHS[i], '\0'};
+        glyphs[i] = TTF_RenderText_Solid(atlas->font, glyph_text, atlas->color);
+        if (glyphs[i] == NULL) {
+            LOG_ERROR("Unable to render digit '%c': %s\n", ATLAS_GLYPHS[i], TTF_GetError());
+            for (int j = 0; j < i; j++) SDL_FreeSurface(glyphs[j]);
+            return -1;
+        }
+        total_w += glyphs[i]->w;
+        if (glyphs[i]->h > max_h) max_h = glyphs[i]->h;
+    }
+
+    SDL_Surface *screen = SDL_GetVideoSurface();
+    if (screen) {
+        atlas->surface = SDL_CreateRGBSurface(SDL_SWSURFACE, total_w, max_h, screen->format->BitsPerPixel,
+                                              screen->format->Rmask, screen->format->Gmask, screen->format->Bmask, 0);
+    } else {
+        atlas->surface = SDL_CreateRGBSurface(SDL_SWSURFACE, total_w, max_h, 32, 0x00ff0000, 0x0000ff00, 0x000000ff, 0);
+    }
+    if (atlas->surface == NULL) {
+        LOG_ERROR("Unable to create digit atlas: %s\n", SDL_GetError());
+        for (int i = 0; i < ATLAS_GLYPH_COUNT; i++) SDL_FreeSurface(glyphs[i]);
+        return -1;
+    }
+
+    // Solid text is one color on a transparent index, so any other color works as the key
+    Uint32 key = (atlas->color.r == 255 && atlas->color.g == 0 && atlas->color.b == 255)
+                 ? SDL_MapRGB(atlas->surface->format, 0, 255, 255)
+                 : SDL_MapRGB(atlas->surface->format, 255, 0, 255);
+    SDL_FillRect(atlas->surface, NULL, key);
+
+    int x = 0;
+    for (int i = 0; i < ATLAS_GLYPH_COUNT; i++) {
+        SDL_Rect dst = {x, 0, 0, 0};
+        SDL_BlitSurface(glyphs[i], NULL, atlas->surface, &dst);
+        atlas->glyphs[i].x = x;
+        atlas->glyphs[i].y = 0;
+        atlas->glyphs[i].w = glyphs[i]->w;
+        atlas->glyphs[i].h = glyphs[i]->h;
+        x += glyphs[i]->w;
+        SDL_FreeSurface(glyphs[i]);
+    }
+    SDL_SetColorKey(atlas->surface, SDL_SRCCOLORKEY | SDL_RLEACCEL, key);
+    return 0;
+}
+
+/**
+ * @brief Finds or builds the digit atlas of a font and color.
+ * @param font The font.
+ * @param color The text color.
+ * @return The atlas, or NULL on failure.
+ */
+static DigitAtlas *get_atlas(TTF_Font *font, SDL_Color color) {
+    int victim = 0;
+
+    for (int i = 0; i < TEXT_ATLAS_SIZE; i++) {
+        DigitAtlas *atlas = &atlases[i];
+        if (atlas->surface && atlas->font == font && same_color(atlas->color, color)) {
+            atlas->last_used = ++use_counter;
+            return atlas;
+        }
+        if (atlases[victim].surface && (!atlas->surface || atlas->last_used < atlases[victim].last_used)) {
+            victim = i;
+        }
+    }
+
+    DigitAtlas *atlas = &atlases[victim];
+    if (atlas->surface) {
+        SDL_FreeSurface(atlas->surface);
+        atlas->surface = NULL;
+    }
+    atlas->font = font;
+    atlas->color = color;
+    if (build_atlas(atlas) < 0) {
+        return NULL;
+    }
+    atlas->last_used = ++use_counter;
+    return atlas;
+}
+
+int text_draw_number(SDL_Surface *screen, TTF_Font *font, int value, SDL_Color color, int x, int y) {
+    DigitAtlas *atlas = get_atlas(font, color);
+    if (atlas == NULL) {
+        return 0;
+    }
+
+    char digits[16];
+    snprintf(digits, sizeof(digits), "%d", value);
+    int width = 0;
+    for (const char *c = digits; *c; c++) {
+        int index = (*c == '-') ? ATLAS_GLYPH_COUNT - 1 : *c - '0';
+        SDL_Rect src = atlas->glyphs[index];
+        SDL_Rect dst = {x + width, y, 0, 0};
+        dirty_blit(atlas->surface, &src, screen, &dst);
+        width += atlas->glyphs[index].w;
+    }
+    return width;
+}
+
+int text_draw_labeled_number(SDL_Surface *screen, TTF_Font *font, const char *label, int value, SDL_Color color, int x, int y) {
+    int space = 0;
+    TTF_GlyphMetrics(font, ' ', NULL, NULL, NULL, NULL, &space);
+    int width = text_draw(screen, font, label, color, x, y) + space;
+    return width + text_draw_number(screen, font, value, color, x + width, y);
+}
+
+void text_cache_clear(void) {
+    for (int i = 0; i < TEXT_CACHE_SIZE; i++) {
+        if (cache[i].surface) {
+            SDL_FreeSurface(cache[i].surface);
+            free(cache[i].text);
+        }
+        memset(&cache[i], 0, sizeof(cache[i]));
+    }
+    for (int i = 0; i < TEXT_ATLAS_SIZE; i++) {
+        if (atlases[i].surface) {
+            SDL_FreeSurface(atlases[i].surface);
+        }
+        memset(&atlases[i], 0, sizeof(atlases[i]));
+    }
+}
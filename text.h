@@ -0,0 +1,71 @@
+/**
+ * @file text.h
+ * @brief Cached text rendering for HUD strings and digit-atlas number drawing.
+ * @author MohamedNourMraad
+ * @date 2025-05-21
+ * @version 1.0
+ */
+
+#ifndef TEXT_H
+#define TEXT_H
+
+#include <SDL/SDL.h>
+#include <SDL/SDL_ttf.h>
+
+#define TEXT_CACHE_SIZE 32   // Rendered strings kept alive (least recently used is evicted)
+#define TEXT_ATLAS_SIZE 8    // Digit atlases kept alive, one per (font, color)
+
+/**
+ * @brief Returns the rendered surface for a string, rendering it only on a cache miss.
+ *        The surface belongs to the cache: do not free it.
+ * @param font The font to render with.
+ * @param text The string to render.
+ * @param color The text color.
+ * @return The rendered surface, or NULL on failure.
+ */
+SDL_Surface *text_render_cached(TTF_Font *font, const char *text, SDL_Color color);
+
+/**
+ * @brief Draws a string through the cache.
+ * @param screen The SDL surface to render on.
+ * @param font The font to render with.
+ * @param text The string to draw.
+ * @param color The text color.
+ * @param x The x-coordinate on screen.
+ * @param y The y-coordinate on screen.
+ * @return The width drawn in pixels (0 on failure).
+ */
+int text_draw(SDL_Surface *screen, TTF_Font *font, const char *text, SDL_Color color, int x, int y);
+
+/**
+ * @brief Draws an integer from pre-rendered digit glyphs, without any FreeType work.
+ * @param screen The SDL surface to render on.
+ * @param font The font to render with.
+ * @param value The number to draw.
+ * @param color The text color.
+ * @param x The x-coordinate on screen.
+ * @param y The y-coordinate on screen.
+ * @return The width drawn in pixels (0 on failure).
+ */
+int text_draw_number(SDL_Surface *screen, TTF_Font *font, int value, SDL_Color color, int x, int y);
+
+/**
+ * @brief Draws "label value": the label from the cache, the value from the digit atlas.
+ * @param screen The SDL surface to render on.
+ * @param font The font to render with.
+ * @param label The fixed part of the text (without trailing space).
+ * @param value The number drawn after the label.
+ * @param color The text color.
+ * @param x The x-coordinate on screen.
+ * @param y The y-coordinate on screen.
+ * @return The width drawn in pixels.
+ */
+int text_draw_labeled_number(SDL_Surface *screen, TTF_Font *font, const char *label, int value, SDL_Color color, int x, int y);
+
+/**
+ * @brief Frees every cached string and digit atlas. Call before closing a font.
+ * @return Nothing.
+ */
+void text_cache_clear(void);
+
+#endif // TEXT_H
@@ -0,0 +1,64 @@
+/**
+ * @file timestep.c
+ * @brief Fixed-rate simulation clock with interpolated rendering and a render frame cap.
+ * @author MohamedNourMraad
+ * @date 2025-05-22
+ * @version 1.0
+ */
+
+#include <SDL/SDL.h>
+#include <stdlib.h>
+#include "timestep.h"
+#include "input.h"
+
+void sim_clock_init(SimClock *clock, Uint32 now) {
+    clock->last_ticks = now;
+    clock->frame_start = now;
+    clock->accumulator = 0;
+    clock->sim_time = 0;
+}
+
+void sim_clock_advance(SimClock *clock, Uint32 now) {
+    Uint32 elapsed = now - clock->last_ticks;
+    if (elapsed > SIM_MAX_FRAME_MS) {
+        elapsed = SIM_MAX_FRAME_MS; // Drop the time spent blocked instead of fast-forwarding through it
+    }
+    clock->accumulator += elapsed;
+    clock->last_ticks = now;
+    clock->frame_start = now;
+}
+
+int sim_clock_step(SimClock *clock) {
+    if (clock->accumulator < SIM_STEP_MS) {
+        return 0;
+    }
+    clock->accumulator -= SIM_STEP_MS;
+    clock->sim_time += SIM_STEP_MS;
+    return 1;
+}
+
+float sim_clock_alpha(const SimClock *clock) {
+    return (float)clock->accumulator / SIM_STEP_MS;
+}
+
+SDL_Rect sim_lerp_rect(SDL_Rect prev, SDL_Rect cur, float alpha) {
+    if (abs(cur.x - prev.x) > SIM_SNAP_DISTANCE || abs(cur.y - prev.y) > SIM_SNAP_DISTANCE) {
+        return cur;
+    }
+    SDL_Rect r = cur;
+    r.x = prev.x + (int)((cur.x - prev.x) * alpha);
+    r.y = prev.y + (int)((cur.y - prev.y) * alpha);
+    return r;
+}
+
+void sim_clock_cap_frame(const SimClock *clock) {
+#if RENDER_FPS_CAP > 0
+    Uint32 frame_ms = 1000 / RENDER_FPS_CAP;
+    Uint32 spent = input_ticks() - clock->frame_start;
+    if (spent < frame_ms) {
+        SDL_Delay(frame_ms - spent);
+    }
+#else
+    (void)clock;
+#endif
+}
@@ -0,0 +1,79 @@
+/**
+ * @file timestep.h
+ * @brief Fixed-rate simulation clock with interpolated rendering and a render frame cap.
+ * @author MohamedNourMraad
+ * @date 2025-05-22
+ * @version 1.0
+ */
+
+#ifndef TIMESTEP_H
+#define TIMESTEP_H
+
+#include <SDL/SDL.h>
+
+#define SIM_STEP_MS 8          // Simulation step: 8 ms = 125 Hz, an exact number of milliseconds
+#define SIM_MAX_FRAME_MS 250   // Longest real frame fed to the simulation (after the enigma, the maze...)
+#define SIM_SNAP_DISTANCE 64   // A move longer than this between two steps is a teleport, not interpolated
+
+#ifndef RENDER_FPS_CAP
+#define RENDER_FPS_CAP 60      // Rendered frames per second, 0 for uncapped (override with -DRENDER_FPS_CAP=n)
+#endif
+
+/**
+ * @brief Accumulates real time and hands it out as fixed simulation steps.
+ */
+typedef struct {
+    Uint32 last_ticks;   // Real time of the previous frame
+    Uint32 frame_start;  // Real time at the start of the current frame
+    Uint32 accumulator;  // Real time not yet simulated (always < SIM_STEP_MS between frames)
+    Uint32 sim_time;     // Total simulated time in ms
+} SimClock;
+
+/**
+ * @brief Starts the clock.
+ * @param clock Pointer to the clock.
+ * @param now Current time (input_ticks).
+ * @return Nothing.
+ */
+void sim_clock_init(SimClock *clock, Uint32 now);
+
+/**
+ * @brief Adds the real time elapsed since the previous frame to the accumulator.
+ * @param clock Pointer to the clock.
+ * @param now Current time (input_ticks).
+ * @return Nothing.
+ */
+void sim_clock_advance(SimClock *clock, Uint32 now);
+
+/**
+ * @brief Consumes one simulation step if enough time has accumulated.
+ *        Use as: while (sim_clock_step(&clock)) { update(SIM_STEP_MS); }
+ * @param clock Pointer to the clock.
+ * @return 1 if a step must be simulated, 0 otherwise.
+ */
+int sim_clock_step(SimClock *clock);
+
+/**
+ * @brief Fraction of a step elapsed since the last simulated state, for interpolation.
+ * @param clock Pointer to the clock.
+ * @return A value in [0, 1).
+ */
+float sim_clock_alpha(const SimClock *clock);
+
+/**
+ * @brief Interpolates a position between the previous and the current simulation step.
+ * @param prev Position before the last step.
+ * @param cur Position after the last step.
+ * @param alpha Interpolation factor from sim_clock_alpha.
+ * @return The position to draw (cur itself if the object teleported).
+ */
+SDL_Rect sim_lerp_rect(SDL_Rect prev, SDL_Rect cur, float alpha);
+
+/**
+ * @brief Sleeps for the rest of the frame so rendering does not exceed RENDER_FPS_CAP.
+ * @param clock Pointer to the clock.
+ * @return Nothing.
+ */
+void sim_clock_cap_frame(const SimClock *clock);
+
+#endif // TIMESTEP_H
@@ -0,0 +1,451 @@
+/**
+ * @file packer.c
+ * @brief Offline asset packer: packs every image of the given directories into
+ *        atlas pages and appends the audio and font files, producing the archive
+ *        read by pak.c. Usage: packer assets.pak . clock
+ * @author MohamedNourMraad
+ * @date 2025-05-25
+ * @version 1.0
+ */
+
+#include <SDL/SDL.h>
+#include <SDL/SDL_image.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <dirent.h>
+#include "../pak.h"
+
+#define ASSET_OPAQUE 0    // Same values as assets.h
+#define ASSET_COLORKEY 1
+#define ASSET_ALPHA 2
+
+/**
+ * @brief One input file.
+ */
+typedef struct {
+    char name[PAK_NAME_MAX];
+    PakType type;
+    int kind;           // Images: transparency kind
+    int w, h;           // Images: size
+    Uint8 *pixels;      // Images: R, G, B, A bytes, pitch 4 * w
+    Uint8 *data;        // Raw files: content
+    size_t size;
+    int page, x, y;     // Images: place in the atlas
+} Item;
+
+/**
+ * @brief One atlas page being filled, shelf by shelf.
+ */
+typedef struct {
+    int kind;
+    int w, h;           // Used size
+    int shelf_y, shelf_h, shelf_x;
+    Uint8 *pixels;      // PAK_PAGE_SIZE wide while packing
+    int stride;         // Width the pixels were allocated with
+} Page;
+
+static Item *items = NULL;
+static int item_count = 0, item_capacity = 0;
+static Page *pages = NULL;
+static int page_count = 0, page_capacity = 0;
+
+/**
+ * @brief Tells whether a file name ends with one of the given extensions.
+ * @param name The file name.
+ * @param exts NULL-terminated list of extensions (with the dot).
+ * @return 1 if it does, 0 otherwise.
+ */
+static int has_ext(const char *name, const char *const *exts) {
+    const char *dot = strrchr(name, '.');
+    if (dot == NULL) return 0;
+    for (int i = 0; exts[i]; i++) {
+        if (strcasecmp(dot, exts[i]) == 0) return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Reserves one more input item.
+ * @return The new item (zeroed), or NULL if out of memory.
+ */
+static Item *new_item(void) {
+    if (item_count == item_capacity) {
+        int capacity = item_capacity ? item_capacity * 2 : 256;
+        Item *grown = realloc(items, capacity * sizeof(Item));
+        if (grown == NULL) return NULL;
+        items = grown;
+        item_capacity = capacity;
+    }
+    memset(&items[item_count], 0, sizeof(Item));
+    return &items[item_count++];
+}
+
+/**
+ * @brief Reads one pixel of a surface as raw bits (the surface must be locked if needed).
+ * @param s The surface.
+ * @param x The x-coordinate.
+ * @param y The y-coordinate.
+ * @return The raw pixel value.
+ */
+static Uint32 get_pixel(SDL_Surface *s, int x, int y) {
+    Uint8 *p = (Uint8 *)s->pixels + y * s->pitch + x * s->format->BytesPerPixel;
+    switch (s->format->BytesPerPixel) {
+        case 1: return *p;
+        case 2: return *(Uint16 *)p;
+        case 3:
+            if (SDL_BYTEORDER == SDL_BIG_ENDIAN) {
+                return p[0] << 16 | p[1] << 8 | p[2];
+            }
+            return p[0] | p[1] << 8 | p[2] << 16;
+        case 4: return *(Uint32 *)p;
+        default: return 0;
+    }
+}
+
+/**
+ * @brief Decodes an image to RGBA bytes (colorkeyed pixels get alpha 0) and
+ *        classifies it the way assets.c does.
+ * @param it The item to fill (name already set).
+ * @param path The file to decode.
+ * @return 0 on success, -1 on failure.
+ */
+static int read_image(Item *it, const char *path) {
+    SDL_Surface *src = IMG_Load(path);
+    if (src == NULL) {
+        fprintf(stderr, "packer: impossible de lire %s : %s\n", path, IMG_GetError());
+        return -1;
+    }
+    it->type = PAK_IMAGE;
+    it->w = src->w;
+    it->h = src->h;
+    it->pixels = malloc((size_t)src->w * src->h * 4);
+    if (it->pixels == NULL) {
+        SDL_FreeSurface(src);
+        return -1;
+    }
+
+    int keyed = (src->flags & SDL_SRCCOLORKEY) != 0;
+    int has_transparent = 0, has_partial = 0;
+    if (SDL_MUSTLOCK(src)) SDL_LockSurface(src);
+    for (int y = 0; y < src->h; y++) {
+        for (int x = 0; x < src->w; x++) {
+            Uint8 *out = it->pixels + ((size_t)y * src->w + x) * 4;
+            Uint32 raw = get_pixel(src, x, y);
+            if (keyed && raw == src->format->colorkey) {
+                out[0] = out[1] = out[2] = out[3] = 0;
+            } else {
+                SDL_GetRGBA(raw, src->format, &out[0], &out[1], &out[2], &out[3]);
+            }
+            if (out[3] == 0) has_transparent = 1;
+            else if (out[3] != 255) has_partial = 1;
+        }
+    }
+    if (SDL_MUSTLOCK(src)) SDL_UnlockSurface(src);
+    SDL_FreeSurface(src);
+
+    it->kind = has_partial ? ASSET_ALPHA : (has_transparent || keyed) ? ASSET_COLORKEY : ASSET_OPAQUE;
+    return 0;
+}
+
+/**
+ * @brief Reads a whole file.
+ * @param it The item to fill (name already set).
+ * @param path The file to read.
+ * @return 0 on success, -1 on failure.
+ */
+static int read_raw(Item *it, const char *path) {
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) {
+        fprintf(stderr, "packer: impossible d'ouvrir %s\n", path);
+        return -1;
+    }
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    it->type = PAK_RAW;
+    it->size = size > 0 ? (size_t)size : 0;
+    it->data = malloc(it->size ? it->size : 1);
+    if (it->data == NULL || fread(it->data, 1, it->size, f) != it->size) {
+        fprintf(stderr, "packer: lecture de %s incomplète\n", path);
+        fclose(f);
+        return -1;
+    }
+    fclose(f);
+    return 0;
+}
+
+/**
+ * @brief Adds the images, sounds and fonts of one directory (not recursive).
+ * @param dir The directory, "." for the game directory itself.
+ * @return 0 on success, -1 on failure.
+ */
+static int scan_dir(const char *dir) {
+    static const char *const images[] = {".png", ".jpg", NULL};
+    static const char *const raws[] = {".wav", ".mp3", ".ogg", ".ttf", NULL};
+    DIR *d = opendir(dir);
+    if (d == NULL) {
+        fprintf(stderr, "packer: dossier %s introuvable\n", dir);
+        return -1;
+    }
+    struct dirent *de;
+    while ((de = readdir(d)) != NULL) {
+        int image = has_ext(de->d_name, images);
+        if (!image && !has_ext(de->d_name, raws)) continue;
+
+        char name[PAK_NAME_MAX + 1];
+        // Names are the paths the game passes to IMG_Load, relative to the game directory
+        int len = strcmp(dir, ".") == 0 ? snprintf(name, sizeof(name), "%s", de->d_name)
+                                        : snprintf(name, sizeof(name), "%s/%s", dir, de->d_name);
+        if (len >= PAK_NAME_MAX) {
+            fprintf(stderr, "packer: nom trop long, %s/%s ignoré\n", dir, de->d_name);
+            continue;
+        }
+        Item *it = new_item();
+        if (it == NULL) {
+            closedir(d);
+            return -1;
+        }
+        memcpy(it->name, name, len + 1);
+        if ((image ? read_image(it, name) : read_raw(it, name)) < 0) {
+            item_count--; // Skip unreadable files, the game reports them at load time
+        }
+    }
+    closedir(d);
+    return 0;
+}
+
+/**
+ * @brief Opens a new page.
+ * @param kind Transparency kind of its images.
+ * @param w Allocated width.
+ * @param h Allocated height.
+ * @return The page index, or -1 if out of memory.
+ */
+static int new_page(int kind, int w, int h) {
+    if (page_count == page_capacity) {
+        int capacity = page_capacity ? page_capacity * 2 : 16;
+        Page *grown = realloc(pages, capacity * sizeof(Page));
+        if (grown == NULL) return -1;
+        pages = grown;
+        page_capacity = capacity;
+    }
+    Page *p = &pages[page_count];
+    memset(p, 0, sizeof(Page));
+    p->kind = kind;
+    p->stride = w;
+    p->pixels = calloc((size_t)w * h, 4); // Unused space stays transparent black
+    if (p->pixels == NULL) return -1;
+    return page_count++;
+}
+
+/**
+ * @brief Sorts images tallest first (then by name, for a reproducible archive).
+ * @param a First item index.
+ * @param b Second item index.
+ * @return Comparison result.
+ */
+static int compare_height(const void *a, const void *b) {
+    const Item *ia = &items[*(const int *)a], *ib = &items[*(const int *)b];
+    if (ia->h != ib->h) return ib->h - ia->h;
+    return strcmp(ia->name, ib->name);
+}
+
+/**
+ * @brief Shelf-packs the images of one kind: tallest first, left to right,
+ *        a new shelf when a row is full and a new page when the page is full.
+ * @param kind The transparency kind.
+ * @return 0 on success, -1 on failure.
+ */
+static int pack_kind(int kind) {
+    int *order = malloc((item_count ? item_count : 1) * sizeof(int));
+    if (order == NULL) return -1;
+    int n = 0;
+    for (int i = 0; i < item_count; i++) {
+        if (items[i].type == PAK_IMAGE && items[i].kind == kind) order[n++] = i;
+    }
+    qsort(order, n, sizeof(int), compare_height);
+
+    int current = -1, failed = 0;
+    for (int k = 0; k < n && !failed; k++) {
+        Item *it = &items[order[k]];
+        if (it->w > PAK_PAGE_SIZE || it->h > PAK_PAGE_SIZE) {
+            // Too big to share a page (full-screen backgrounds, collision maps)
+            it->page = new_page(kind, it->w, it->h);
+            if (it->page < 0) {
+                failed = 1;
+                break;
+            }
+            pages[it->page].w = it->w;
+            pages[it->page].h = it->h;
+            it->x = it->y = 0;
+            continue;
+        }
+        Page *p = current >= 0 ? &pages[current] : NULL;
+        if (p && p->shelf_x + it->w > PAK_PAGE_SIZE) {
+            p->shelf_y += p->shelf_h; // Next shelf
+            p->shelf_x = 0;
+            p->shelf_h = 0;
+        }
+        if (p == NULL || p->shelf_y + it->h > PAK_PAGE_SIZE) {
+            current = new_page(kind, PAK_PAGE_SIZE, PAK_PAGE_SIZE);
+            if (current < 0) {
+                failed = 1;
+                break;
+            }
+            p = &pages[current];
+        }
+        it->page = current;
+        it->x = p->shelf_x;
+        it->y = p->shelf_y;
+        p->shelf_x += it->w;
+        if (it->h > p->shelf_h) p->shelf_h = it->h;
+        if (p->shelf_x > p->w) p->w = p->shelf_x;
+        if (p->shelf_y + p->shelf_h > p->h) p->h = p->shelf_y + p->shelf_h;
+    }
+    free(order);
+    return failed ? -1 : 0;
+}
+
+/**
+ * @brief Copies every packed image into its page.
+ * @return Nothing.
+ */
+static void blit_items(void) {
+    for (int i = 0; i < item_count; i++) {
+        Item *it = &items[i];
+        if (it->type != PAK_IMAGE) continue;
+        Page *p = &pages[it->page];
+        for (int y = 0; y < it->h; y++) {
+            memcpy(p->pixels + ((size_t)(it->y + y) * p->stride + it->x) * 4,
+                   it->pixels + (size_t)y * it->w * 4, (size_t)it->w * 4);
+        }
+    }
+}
+
+/**
+ * @brief Sorts items by name, the order pak_find searches them in.
+ * @param a First item.
+ * @param b Second item.
+ * @return strcmp of the names.
+ */
+static int compare_name(const void *a, const void *b) {
+    return strcmp(((const Item *)a)->name, ((const Item *)b)->name);
+}
+
+/**
+ * @brief Pads the output to the archive alignment.
+ * @param f The output file.
+ * @param offset Current offset, advanced to the padded one.
+ * @return Nothing.
+ */
+static void align(FILE *f, Uint32 *offset) {
+    static const Uint8 zeros[PAK_ALIGN] = {0};
+    Uint32 pad = (PAK_ALIGN - *offset % PAK_ALIGN) % PAK_ALIGN;
+    fwrite(zeros, 1, pad, f);
+    *offset += pad;
+}
+
+/**
+ * @brief Writes the archive: header, page table, entry table, then the page
+ *        pixels and raw files, each aligned.
+ * @param path The archive file.
+ * @return 0 on success, -1 on failure.
+ */
+static int write_archive(const char *path) {
+    PakPage *table = calloc(page_count ? page_count : 1, sizeof(PakPage));
+    PakEntry *entries = calloc(item_count ? item_count : 1, sizeof(PakEntry));
+    FILE *f = fopen(path, "wb");
+    if (table == NULL || entries == NULL || f == NULL) {
+        fprintf(stderr, "packer: impossible d'écrire %s\n", path);
+        free(table);
+        free(entries);
+        if (f) fclose(f);
+        return -1;
+    }
+
+    // Lay the data out first so the tables can be written in one go
+    Uint32 offset = sizeof(PakHeader) + page_count * sizeof(PakPage) + item_count * sizeof(PakEntry);
+    offset += (PAK_ALIGN - offset % PAK_ALIGN) % PAK_ALIGN;
+    for (int i = 0; i < page_count; i++) {
+        table[i].w = pages[i].w;
+        table[i].h = pages[i].h;
+        table[i].kind = pages[i].kind;
+        table[i].offset = offset;
+        offset += pages[i].w * pages[i].h * 4;
+        offset += (PAK_ALIGN - offset % PAK_ALIGN) % PAK_ALIGN;
+    }
+    for (int i = 0; i < item_count; i++) {
+        Item *it = &items[i];
+        PakEntry *e = &entries[i];
+        memcpy(e->name, it->name, PAK_NAME_MAX);
+        e->type = it->type;
+        if (it->type == PAK_IMAGE) {
+            e->page = it->page;
+            e->x = it->x;
+            e->y = it->y;
+            e->w = it->w;
+            e->h = it->h;
+        } else {
+            e->offset = offset;
+            e->size = it->size;
+            offset += it->size;
+            offset += (PAK_ALIGN - offset % PAK_ALIGN) % PAK_ALIGN;
+        }
+    }
+
+    PakHeader header;
+    memcpy(header.magic, PAK_MAGIC, 4);
+    header.version = PAK_VERSION;
+    header.page_count = page_count;
+    header.entry_count = item_count;
+    fwrite(&header, sizeof(header), 1, f);
+    fwrite(table, sizeof(PakPage), page_count, f);
+    fwrite(entries, sizeof(PakEntry), item_count, f);
+    Uint32 written = sizeof(PakHeader) + page_count * sizeof(PakPage) + item_count * sizeof(PakEntry);
+    align(f, &written);
+    for (int i = 0; i < page_count; i++) {
+        for (int y = 0; y < pages[i].h; y++) {
+            fwrite(pages[i].pixels + (size_t)y * pages[i].stride * 4, 4, pages[i].w, f);
+        }
+        written += pages[i].w * pages[i].h * 4;
+        align(f, &written);
+    }
+    for (int i = 0; i < item_count; i++) {
+        if (items[i].type != PAK_RAW) continue;
+        fwrite(items[i].data, 1, items[i].size, f);
+        written += items[i].size;
+        align(f, &written);
+    }
+
+    int ok = !ferror(f) && written == offset;
+    fclose(f);
+    free(table);
+    free(entries);
+    if (!ok) {
+        fprintf(stderr, "packer: erreur d'écriture de %s\n", path);
+        return -1;
+    }
+    printf("packer: %s, %d fichiers, %d pages, %u octets\n", path, item_count, page_count, offset);
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 3) {
+        fprintf(stderr, "Usage: %s archive.pak dossier...\n", argv[0]);
+        return 1;
+    }
+    for (int i = 2; i < argc; i++) {
+        if (scan_dir(argv[i]) < 0) return 1;
+    }
+    for (int kind = ASSET_OPAQUE; kind <= ASSET_ALPHA; kind++) {
+        if (pack_kind(kind) < 0) {
+            fprintf(stderr, "packer: mémoire insuffisante\n");
+            return 1;
+        }
+    }
+    blit_items();
+    qsort(items, item_count, sizeof(Item), compare_name); // Pages are filled, item order is free again
+    return write_archive(argv[1]) < 0 ? 1 : 0;
+}